@@ -1,8 +1,24 @@
+#ifndef FLOAT24_HPP
+#define FLOAT24_HPP
+
 #include <iostream>
 #include <cmath>
 #include <bitset>
 #include <string>
 #include <sstream>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "float24soft.hpp"
+
+/** 算术后端，编译时以 -DFLOAT24_BACKEND=FLOAT24_BACKEND_SOFT 选择，也可用 make BACKEND=soft
+    FLOAT24_BACKEND_FLOAT（默认）：扩展为 f32，用硬件浮点计算后向零截断
+    FLOAT24_BACKEND_SOFT：纯整数软浮点（float24soft.hpp），适合没有快速浮点单元的目标 */
+#define FLOAT24_BACKEND_FLOAT 0
+#define FLOAT24_BACKEND_SOFT 1
+#ifndef FLOAT24_BACKEND
+#define FLOAT24_BACKEND FLOAT24_BACKEND_FLOAT
+#endif
 
 /** https://evanw.github.io/float-toy/
 保证精度都是float32的子集，因此float24可以安全转换为float32
@@ -14,6 +30,50 @@
     精度: log_10⁡{(2^(16+1)} := 5.1175        (1-63=-62) 17位尾数精度为5.4
     范围: -Infinity | -2*2^63 | -1*2^-62 | 0 | 1*2^-62 | 2*2^63 | +Infinity
 */
+
+/** 舍入模式：默认向零截断；随机舍入按被截掉部分的大小概率进位，累加时无偏 */
+enum class Float24Rounding : uint8_t
+{
+    TowardZero,
+    Stochastic,
+};
+
+/** 基于计数器的伪随机数发生器
+    第 n 个随机数只由 (key, n) 决定，可复现，也便于批量/向量化按下标生成 */
+class Float24Rng
+{
+private:
+    uint64_t key;
+    uint64_t counter;
+
+    static inline uint32_t mix(uint32_t x)
+    { // lowbias32
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        x ^= x >> 16;
+        return x;
+    }
+
+public:
+    explicit Float24Rng(uint64_t key = 0) : key(key), counter(0) {}
+
+    void inline seed(uint64_t key)
+    {
+        this->key = key;
+        this->counter = 0;
+    }
+    /** @return 第 index 个随机数，不改变内部计数器 */
+    uint32_t inline at(uint64_t index) const
+    {
+        uint32_t block = mix(static_cast<uint32_t>(key) ^ mix(static_cast<uint32_t>(key >> 32) ^ static_cast<uint32_t>(index >> 32)));
+        return mix(static_cast<uint32_t>(index) * 0x9E3779B9U + block);
+    }
+    uint32_t inline next() { return at(counter++); }
+    uint64_t inline position() const { return counter; }
+};
+
 class Float24
 {
 private:
@@ -137,6 +197,70 @@ public:
         f.setExponent(Float24::exponent_max);
         return f;
     }
+    /** 24 位二进制表示：符号位 | 阶码 | 尾数，与 toBinaryString 顺序一致 */
+    uint32_t inline toBits() const { return (static_cast<uint32_t>(sign_exponent) << 16) | mantissa; }
+    static Float24 inline fromBits(uint32_t bits)
+    {
+        Float24 f;
+        f.sign_exponent = static_cast<uint8_t>(bits >> 16);
+        f.mantissa = static_cast<uint16_t>(bits);
+        return f;
+    }
+
+    /** 保序键：按数值从小到大排列的 24 位无符号整数，-0 与 +0 相邻，NaN 位于两端 */
+    static uint32_t inline bitsToOrderKey(uint32_t bits) { return bits & 0x800000 ? ~bits & 0xFFFFFF : bits | 0x800000; }
+    static uint32_t inline orderKeyToBits(uint32_t key) { return key & 0x800000 ? key & 0x7FFFFF : ~key & 0xFFFFFF; }
+    uint32_t inline toOrderKey() const { return bitsToOrderKey(toBits()); }
+    static Float24 inline fromOrderKey(uint32_t key) { return fromBits(orderKeyToBits(key)); }
+
+    /** 当前线程的舍入模式 */
+    static Float24Rounding inline &rounding()
+    {
+        static thread_local Float24Rounding mode = Float24Rounding::TowardZero;
+        return mode;
+    }
+    /** 当前线程随机舍入使用的随机数发生器
+        第 k 个（从 0 起）首次使用 rng() 的线程默认以 k 为 key，各线程的随机序列互不相同，
+        合并各线程的部分和时舍入误差仍可相互抵消；需要与线程调度无关的可复现结果时应显式 seed */
+    static Float24Rng inline &rng()
+    {
+        static std::atomic<uint64_t> threads(0);
+        static thread_local Float24Rng generator(threads.fetch_add(1, std::memory_order_relaxed));
+        return generator;
+    }
+    /** 随机舍入：把 random 的低 7 位加到 float 将被截掉的尾数上，再按截断转换
+        进位会自然传递到阶码，NaN 与 Infinity 保持不变 */
+    static Float24 inline stochastic(float value, uint32_t random)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if (((bits >> 23) & 0xFF) != 0xFF)
+            bits += random & 0x7F;
+        std::memcpy(&value, &bits, sizeof(value));
+        return truncate(value);
+    }
+    /** 随机舍入，输入为 f64：用于运算结果，避免先舍入到 f32 带来的偏差
+        random 的 32 位全部落在 Float24 尾数末位之下 */
+    static Float24 inline stochastic(double value, uint32_t random)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if (((bits >> 52) & 0x7FF) != 0x7FF)
+        {
+            bits += static_cast<uint64_t>(random) << (52 - 16 - 32);
+            bits &= ~((1ULL << (52 - 23)) - 1); // 使转换为 f32 时精确
+        }
+        std::memcpy(&value, &bits, sizeof(value));
+        return truncate(static_cast<float>(value));
+    }
+    /** 向零截断，不受当前线程舍入模式影响 */
+    static Float24 inline truncate(float value)
+    {
+        Float24 f;
+        f.assign(value);
+        return f;
+    }
+
     /** @return 静默NaN */
     static Float24 inline qNaN()
     {
@@ -146,10 +270,20 @@ public:
         return f;
     }
 
-    // 单精度浮点数转换为 Float24，注意会可能丢失精度
-    explicit Float24(float value)
+    // 单精度浮点数转换为 Float24，注意会可能丢失精度，舍入方式见 rounding()
+    explicit Float24(float value) : sign_exponent(0), mantissa(0)
+    {
+        if (rounding() == Float24Rounding::Stochastic)
+            *this = stochastic(value, rng().next());
+        else
+            assign(value);
+    }
+
+private:
+    void assign(float value)
     {
-        uint32_t bits = *reinterpret_cast<uint32_t *>(&value);
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
         bool sign = bits >> 31;
         uint8_t exponent = (bits >> 23) & 0xFF; // 8 位阶码
         uint32_t mantissa = bits & 0x7FFFFF;    // 23 位尾数
@@ -188,6 +322,7 @@ public:
         }
     }
 
+public:
     // 不会丢失精度
     float toFloat() const
     {
@@ -208,14 +343,15 @@ public:
                 mantissa = 0;
             }
             else
-            { // 非规格化数
+            { // 非规格化数，0.m * 2^(1-63) 在 f32 中是规格化数
+                exponent = 1 - exponent_bias + 127;
                 while ((mantissa & (1 << 16)) == 0)
                 {
                     mantissa <<= 1;
                     exponent--;
                 }
                 mantissa &= ~(1 << 16); // 移除前导  1
-                exponent = 1;           // 非规格化数指数位为 1
+                mantissa <<= 7;
             }
         }
         else
@@ -224,116 +360,73 @@ public:
             mantissa = mantissa << 7;
         }
         uint32_t bits = (sign << 31) | (exponent << 23) | mantissa;
-        return *reinterpret_cast<float *>(&bits);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
     }
 
-    Float24 operator+(const Float24 &other) const; // { return Float24(this->toFloat() + other.toFloat()); }
-    Float24 operator-(const Float24 &other) const; // { return Float24(this->toFloat() - other.toFloat()); }
-    Float24 operator*(const Float24 &other) const { return Float24(this->toFloat() * other.toFloat()); }
-    Float24 operator/(const Float24 &other) const { return Float24(this->toFloat() / other.toFloat()); }
+    /** 四则运算按 FLOAT24_BACKEND 选择的后端计算，两种后端的结果除 NaN 的位模式外逐位一致
+        随机舍入模式下与后端无关，在 f64 中计算后随机舍入 */
+    Float24 operator+(const Float24 &other) const;
+    Float24 operator-(const Float24 &other) const;
+    Float24 operator*(const Float24 &other) const;
+    Float24 operator/(const Float24 &other) const;
 };
 
-Float24 Float24::operator+(const Float24 &other) const
+/** 在作用域内切换当前线程的舍入模式，离开时恢复 */
+class Float24RoundingScope
 {
-    // NaN + any = NaN
-    if (this->isNaN() || other.isNaN())
-        return qNaN();
-
-    // 0 + any = any
-    if (this->isZero())
-        return other.clone();
-    if (other.isZero())
-        return this->clone();
-
-    // Infinity + what = ?
-    static auto infPlusWhat = [&](Float24 inf, Float24 what) -> Float24
-    {
-        if (what.isInfinity())
-        {
-            if (inf.getSign() == what.getSign())
-                return Float24(inf);
-            return qNaN(); // 正无穷 + 负无穷 = NaN
-        }
-        else
-        {
-            return Float24(inf); // 否则，返回符号位不变的无穷
-        }
-    };
-
-    if (this->isInfinity())
-        return infPlusWhat(*this, other);
-    if (other.isInfinity())
-        return infPlusWhat(other, *this);
-
-    uint32_t f1_sign = this->getSign();
-    uint32_t f2_sign = other.getSign();
-    uint16_t f1_exp = this->getExponent();
-    uint16_t f2_exp = other.getExponent();
-    uint16_t r_exp;
-    uint32_t f1_mant = this->getMantissa();
-    uint32_t f2_mant = other.getMantissa();
-
-    // 对于规格化数，添加隐含的前导 1
-    if (f1_exp != 0)
-        f1_mant |= (1 << 16);
-    if (f2_exp != 0)
-        f2_mant |= (1 << 16);
-
-    if (f1_exp > f2_exp)
-    { // 指数较小的那个浮点数的尾数向右移动
-        f2_mant >>= f1_exp - f2_exp;
-        r_exp = f1_exp;
-    }
-    else
-    {
-        f1_mant >>= f2_exp - f1_exp;
-        r_exp = f2_exp;
-    }
+private:
+    Float24Rounding saved;
+
+public:
+    explicit Float24RoundingScope(Float24Rounding mode) : saved(Float24::rounding()) { Float24::rounding() = mode; }
+    ~Float24RoundingScope() { Float24::rounding() = saved; }
+    Float24RoundingScope(const Float24RoundingScope &) = delete;
+    Float24RoundingScope &operator=(const Float24RoundingScope &) = delete;
+};
 
-    uint32_t r_mant;
-    uint32_t r_sign = f1_sign;
+#if FLOAT24_BACKEND == FLOAT24_BACKEND_SOFT
+#define FLOAT24_BACKEND_OP(op, soft) return fromBits(soft(this->toBits(), other.toBits()))
+#else
+#define FLOAT24_BACKEND_OP(op, soft) return Float24(this->toFloat() op other.toFloat())
+#endif
 
-    if (f1_sign ^ f2_sign)
-    { // 符号位不同，减法
-        if (f1_mant > f2_mant)
-        {
-            r_sign = f1_sign;
-            r_mant = f1_mant - f2_mant;
-        }
-        else if (f2_mant > f1_mant)
-        {
-            r_mant = f2_mant - f1_mant;
-            r_sign = f2_sign;
-        }
-        else // 抵消
-            return Float24(r_sign, 0, 0);
+inline Float24 Float24::operator+(const Float24 &other) const
+{
+    // 随机舍入：f64 下求和后再舍入，否则对阶时移出的低位会被直接丢弃
+    if (rounding() == Float24Rounding::Stochastic)
+        return stochastic(static_cast<double>(this->toFloat()) + other.toFloat(), rng().next());
+    FLOAT24_BACKEND_OP(+, float24SoftAdd);
+}
 
-        while (r_mant < (1 << 16) && r_exp > 0)
-        { // 对阶
-            r_mant <<= 1;
-            r_exp--;
-        }
-    }
-    else
-    { // 符号位相同，加法
-        r_mant = f1_mant + f2_mant;
-        if (r_mant & (1 << 17))
-        {
-            r_mant >>= 1;
-            r_exp++;
-        }
-    }
+inline Float24 Float24::operator-(const Float24 &other) const
+{
+    if (rounding() == Float24Rounding::Stochastic)
+        return stochastic(static_cast<double>(this->toFloat()) - other.toFloat(), rng().next());
+    FLOAT24_BACKEND_OP(-, float24SoftSub);
+}
 
-    // 对于规格化数，移除前导 1
-    if (r_exp != 0)
-        r_mant &= ~(1 << 16);
+inline Float24 Float24::operator*(const Float24 &other) const
+{
+    if (rounding() == Float24Rounding::Stochastic)
+        return stochastic(static_cast<double>(this->toFloat()) * other.toFloat(), rng().next());
+    FLOAT24_BACKEND_OP(*, float24SoftMul);
+}
 
-    return Float24(r_sign, r_exp, r_mant);
+inline Float24 Float24::operator/(const Float24 &other) const
+{
+    if (rounding() == Float24Rounding::Stochastic)
+        return stochastic(static_cast<double>(this->toFloat()) / other.toFloat(), rng().next());
+    FLOAT24_BACKEND_OP(/, float24SoftDiv);
 }
 
-Float24 Float24::operator-(const Float24 &other) const
+#undef FLOAT24_BACKEND_OP
+
+/** @return 编译时选择的算术后端名称，用于基准测试记录 */
+inline const char *float24BackendName()
 {
-    Float24 neg_other = other.clone();
-    neg_other.setSign(!other.getSign());
-    return *this + neg_other;
+    return FLOAT24_BACKEND == FLOAT24_BACKEND_SOFT ? "soft" : "float";
 }
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef FLOAT24ARRAY_HPP
+#define FLOAT24ARRAY_HPP
+
+#include <stdexcept>
+#include <vector>
+#include "float24dispatch.hpp"
+
+/** 惰性表达式模板
+    a * b + c * d 等数组表达式只构造表达式树，赋值时才在一个循环中逐元素求值：
+    每个元素读一次各操作数，在 f32 中计算整条表达式，最后只舍入一次（向零截断），
+    不产生临时数组；求值循环按分派的指令集级别编译，可被向量化
+
+    表达式按值保存子节点，数组叶子只保存指针，表达式的生命期不应超过其引用的数组
+    每种节点以静态成员 broadcast 标明是否为（只含标量的）广播表达式，其 size() 无意义；
+    非广播的操作数长度必须相同，空数组与非空数组同样视为长度不符 */
+template <typename E>
+struct Float24Expr
+{
+    const E inline &self() const { return static_cast<const E &>(*this); }
+};
+
+/** 数组叶子 */
+class Float24ArrayLeaf : public Float24Expr<Float24ArrayLeaf>
+{
+private:
+    const Float24 *ptr;
+    size_t n;
+
+public:
+    Float24ArrayLeaf(const Float24 *ptr, size_t n) : ptr(ptr), n(n) {}
+    /** 由 Float24Array 或 Float24ArrayView 构造 */
+    template <typename A>
+    explicit Float24ArrayLeaf(const A &a) : ptr(a.data()), n(a.size()) {}
+    static const bool broadcast = false;
+    size_t inline size() const { return n; }
+    float inline eval(size_t i) const { return float24BitsToFloat(float24Load(ptr + i)); }
+};
+
+/** 标量叶子，广播到每个元素 */
+class Float24ScalarLeaf : public Float24Expr<Float24ScalarLeaf>
+{
+private:
+    float value;
+
+public:
+    explicit Float24ScalarLeaf(float value) : value(value) {}
+    static const bool broadcast = true;
+    size_t inline size() const { return 0; }
+    float inline eval(size_t) const { return value; }
+};
+
+/** 子节点在表达式中的保存方式：数组与视图转为叶子，其余按值保存 */
+template <typename E>
+struct Float24ExprStore
+{
+    typedef E type;
+};
+
+struct Float24OpAdd
+{
+    static float inline apply(float a, float b) { return a + b; }
+};
+struct Float24OpSub
+{
+    static float inline apply(float a, float b) { return a - b; }
+};
+struct Float24OpMul
+{
+    static float inline apply(float a, float b) { return a * b; }
+};
+struct Float24OpDiv
+{
+    static float inline apply(float a, float b) { return a / b; }
+};
+
+template <typename Op, typename L, typename R>
+class Float24BinaryExpr : public Float24Expr<Float24BinaryExpr<Op, L, R>>
+{
+private:
+    typedef typename Float24ExprStore<L>::type LeftNode;
+    typedef typename Float24ExprStore<R>::type RightNode;
+    LeftNode l;
+    RightNode r;
+
+public:
+    static const bool broadcast = LeftNode::broadcast && RightNode::broadcast;
+
+    Float24BinaryExpr(const L &l, const R &r) : l(l), r(r)
+    {
+        if (!LeftNode::broadcast && !RightNode::broadcast && l.size() != r.size())
+            throw std::invalid_argument("array sizes do not match");
+    }
+    size_t inline size() const { return LeftNode::broadcast ? r.size() : l.size(); }
+    float inline eval(size_t i) const { return Op::apply(l.eval(i), r.eval(i)); }
+};
+
+template <typename E>
+class Float24NegateExpr : public Float24Expr<Float24NegateExpr<E>>
+{
+private:
+    typename Float24ExprStore<E>::type e;
+
+public:
+    explicit Float24NegateExpr(const E &e) : e(e) {}
+    static const bool broadcast = Float24ExprStore<E>::type::broadcast;
+    size_t inline size() const { return e.size(); }
+    float inline eval(size_t i) const { return -e.eval(i); }
+};
+
+// 融合求值循环，按指令集级别各编译一份
+// 表达式按值传入，其中的指针与标量不会被 out 的写入别名，可留在寄存器中
+#define FLOAT24_DEFINE_ASSIGN(suffix, attribute)                                   \
+    template <typename E>                                                          \
+    attribute inline void float24Assign_##suffix(Float24 *out, size_t n, E e)        \
+    {                                                                              \
+        for (size_t i = 0; i < n; i++)                                             \
+            float24Store(out + i, float24BitsFromFloat(e.eval(i)));                \
+    }
+
+FLOAT24_DEFINE_ASSIGN(scalar, )
+#ifdef FLOAT24_DISPATCH_X86
+FLOAT24_DEFINE_ASSIGN(sse42, __attribute__((target("sse4.2"))))
+FLOAT24_DEFINE_ASSIGN(avx2, __attribute__((target("avx2"))))
+FLOAT24_DEFINE_ASSIGN(avx512, __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"))))
+#endif
+
+/** out[i] = e[i]，按 float24Kernels() 选定的级别求值 */
+template <typename E>
+void float24Assign(Float24 *out, size_t n, const Float24Expr<E> &expr)
+{
+    const E &e = expr.self();
+    if (!E::broadcast && e.size() != n)
+        throw std::invalid_argument("array sizes do not match");
+    switch (float24Kernels().isa)
+    {
+#ifdef FLOAT24_DISPATCH_X86
+    case Float24Isa::AVX512:
+        return float24Assign_avx512(out, n, e);
+    case Float24Isa::AVX2:
+        return float24Assign_avx2(out, n, e);
+    case Float24Isa::SSE42:
+        return float24Assign_sse42(out, n, e);
+#endif
+    default:
+        return float24Assign_scalar(out, n, e);
+    }
+}
+
+/** 不持有数据的数组视图，可作为表达式的操作数或赋值目标 */
+class Float24ArrayView : public Float24Expr<Float24ArrayView>
+{
+private:
+    Float24 *ptr;
+    size_t n;
+
+public:
+    Float24ArrayView(Float24 *ptr, size_t n) : ptr(ptr), n(n) {}
+    Float24ArrayView(const Float24ArrayView &) = default;
+
+    static const bool broadcast = false;
+    size_t inline size() const { return n; }
+    Float24 inline *data() const { return ptr; }
+    Float24 inline &operator[](size_t i) const { return ptr[i]; }
+    float inline eval(size_t i) const { return float24BitsToFloat(float24Load(ptr + i)); }
+
+    Float24ArrayView &operator=(const Float24ArrayView &other)
+    {
+        float24Assign(ptr, n, other);
+        return *this;
+    }
+    template <typename E>
+    Float24ArrayView &operator=(const Float24Expr<E> &e)
+    {
+        float24Assign(ptr, n, e);
+        return *this;
+    }
+};
+
+/** 持有数据的 Float24 数组 */
+class Float24Array : public Float24Expr<Float24Array>
+{
+private:
+    std::vector<Float24> values;
+
+public:
+    Float24Array() {}
+    explicit Float24Array(size_t n) : values(n) {}
+    Float24Array(size_t n, Float24 fill) : values(n, fill) {}
+    explicit Float24Array(const std::vector<Float24> &values) : values(values) {}
+    template <typename E>
+    Float24Array(const Float24Expr<E> &e) : values(e.self().size())
+    {
+        float24Assign(values.data(), values.size(), e);
+    }
+
+    size_t inline size() const { return values.size(); }
+    Float24 inline *data() { return values.data(); }
+    const Float24 inline *data() const { return values.data(); }
+    Float24 inline &operator[](size_t i) { return values[i]; }
+    const Float24 inline &operator[](size_t i) const { return values[i]; }
+    static const bool broadcast = false;
+    float inline eval(size_t i) const { return float24BitsToFloat(float24Load(values.data() + i)); }
+    Float24ArrayView inline view() { return Float24ArrayView(values.data(), values.size()); }
+
+    template <typename E>
+    Float24Array &operator=(const Float24Expr<E> &e)
+    {
+        if (!E::broadcast)
+            values.resize(e.self().size());
+        float24Assign(values.data(), values.size(), e);
+        return *this;
+    }
+    template <typename E>
+    Float24Array &operator+=(const Float24Expr<E> &e) { return *this = *this + e.self(); }
+    template <typename E>
+    Float24Array &operator-=(const Float24Expr<E> &e) { return *this = *this - e.self(); }
+    template <typename E>
+    Float24Array &operator*=(const Float24Expr<E> &e) { return *this = *this * e.self(); }
+    template <typename E>
+    Float24Array &operator/=(const Float24Expr<E> &e) { return *this = *this / e.self(); }
+    // 与标量的复合赋值，定义在运算符之后
+    Float24Array &operator+=(float s);
+    Float24Array &operator-=(float s);
+    Float24Array &operator*=(float s);
+    Float24Array &operator/=(float s);
+    Float24Array &operator+=(const Float24 &s);
+    Float24Array &operator-=(const Float24 &s);
+    Float24Array &operator*=(const Float24 &s);
+    Float24Array &operator/=(const Float24 &s);
+};
+
+template <>
+struct Float24ExprStore<Float24Array>
+{
+    typedef Float24ArrayLeaf type;
+};
+template <>
+struct Float24ExprStore<Float24ArrayView>
+{
+    typedef Float24ArrayLeaf type;
+};
+
+// 二元运算符：表达式与表达式、表达式与标量（float 或 Float24）
+#define FLOAT24_DEFINE_EXPR_OPERATOR(op, Op)                                                                 \
+    template <typename L, typename R>                                                                        \
+    Float24BinaryExpr<Op, L, R> operator op(const Float24Expr<L> &l, const Float24Expr<R> &r)                \
+    {                                                                                                        \
+        return Float24BinaryExpr<Op, L, R>(l.self(), r.self());                                              \
+    }                                                                                                        \
+    template <typename L>                                                                                    \
+    Float24BinaryExpr<Op, L, Float24ScalarLeaf> operator op(const Float24Expr<L> &l, float r)                \
+    {                                                                                                        \
+        return Float24BinaryExpr<Op, L, Float24ScalarLeaf>(l.self(), Float24ScalarLeaf(r));                  \
+    }                                                                                                        \
+    template <typename R>                                                                                    \
+    Float24BinaryExpr<Op, Float24ScalarLeaf, R> operator op(float l, const Float24Expr<R> &r)                \
+    {                                                                                                        \
+        return Float24BinaryExpr<Op, Float24ScalarLeaf, R>(Float24ScalarLeaf(l), r.self());                  \
+    }                                                                                                        \
+    template <typename L>                                                                                    \
+    Float24BinaryExpr<Op, L, Float24ScalarLeaf> operator op(const Float24Expr<L> &l, const Float24 &r)       \
+    {                                                                                                        \
+        return Float24BinaryExpr<Op, L, Float24ScalarLeaf>(l.self(), Float24ScalarLeaf(r.toFloat()));        \
+    }                                                                                                        \
+    template <typename R>                                                                                    \
+    Float24BinaryExpr<Op, Float24ScalarLeaf, R> operator op(const Float24 &l, const Float24Expr<R> &r)       \
+    {                                                                                                        \
+        return Float24BinaryExpr<Op, Float24ScalarLeaf, R>(Float24ScalarLeaf(l.toFloat()), r.self());        \
+    }
+
+FLOAT24_DEFINE_EXPR_OPERATOR(+, Float24OpAdd)
+FLOAT24_DEFINE_EXPR_OPERATOR(-, Float24OpSub)
+FLOAT24_DEFINE_EXPR_OPERATOR(*, Float24OpMul)
+FLOAT24_DEFINE_EXPR_OPERATOR(/, Float24OpDiv)
+
+inline Float24Array &Float24Array::operator+=(float s) { return *this = *this + s; }
+inline Float24Array &Float24Array::operator-=(float s) { return *this = *this - s; }
+inline Float24Array &Float24Array::operator*=(float s) { return *this = *this * s; }
+inline Float24Array &Float24Array::operator/=(float s) { return *this = *this / s; }
+inline Float24Array &Float24Array::operator+=(const Float24 &s) { return *this = *this + s; }
+inline Float24Array &Float24Array::operator-=(const Float24 &s) { return *this = *this - s; }
+inline Float24Array &Float24Array::operator*=(const Float24 &s) { return *this = *this * s; }
+inline Float24Array &Float24Array::operator/=(const Float24 &s) { return *this = *this / s; }
+
+template <typename E>
+Float24NegateExpr<E> operator-(const Float24Expr<E> &e)
+{
+    return Float24NegateExpr<E>(e.self());
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef FLOAT24ATOMIC_HPP
+#define FLOAT24ATOMIC_HPP
+
+#include <atomic>
+#include "float24.hpp"
+
+/** 原子 Float24，接口与 std::atomic 一致
+    以 24 位二进制表示存放在一个 32 位字中，无锁
+    compare_exchange 按位比较，因此 +0 与 -0、不同的 NaN 视为不等
+    fetch_add / fetch_sub / fetch_min / fetch_max 为 CAS 循环，运算遵循当前线程的舍入模式，
+    随机舍入使用各线程独立的 Float24::rng() */
+class AtomicFloat24
+{
+private:
+    std::atomic<uint32_t> bits;
+
+    /** CAS 循环：以 op(旧值) 替换，返回旧值 */
+    template <typename Op>
+    Float24 inline update(Op op, std::memory_order order)
+    {
+        uint32_t expected = bits.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Float24 old = Float24::fromBits(expected);
+            uint32_t desired = op(old).toBits();
+            if (bits.compare_exchange_weak(expected, desired, order, std::memory_order_relaxed))
+                return old;
+        }
+    }
+
+    /** 同 update，但 op(旧值) 与旧值位模式相同时不写入，直接返回，避免独占缓存行 */
+    template <typename Op>
+    Float24 inline updateIfChanged(Op op, std::memory_order order)
+    {
+        // 不写入时只相当于一次读取，读取不能带 release 语义
+        std::memory_order load_order = order == std::memory_order_release   ? std::memory_order_relaxed
+                                       : order == std::memory_order_acq_rel ? std::memory_order_acquire
+                                                                            : order;
+        uint32_t expected = bits.load(load_order);
+        while (true)
+        {
+            Float24 old = Float24::fromBits(expected);
+            uint32_t desired = op(old).toBits();
+            if (desired == expected)
+                return old;
+            if (bits.compare_exchange_weak(expected, desired, order, load_order))
+                return old;
+        }
+    }
+
+public:
+    AtomicFloat24() : bits(0) {}
+    explicit AtomicFloat24(Float24 value) : bits(value.toBits()) {}
+    AtomicFloat24(const AtomicFloat24 &) = delete;
+    AtomicFloat24 &operator=(const AtomicFloat24 &) = delete;
+
+    bool inline is_lock_free() const { return bits.is_lock_free(); }
+
+    Float24 inline load(std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return Float24::fromBits(bits.load(order));
+    }
+    void inline store(Float24 value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        bits.store(value.toBits(), order);
+    }
+    Float24 inline exchange(Float24 value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Float24::fromBits(bits.exchange(value.toBits(), order));
+    }
+
+    /** 失败时 expected 被更新为当前值 */
+    bool inline compare_exchange_weak(Float24 &expected, Float24 desired, std::memory_order order = std::memory_order_seq_cst)
+    {
+        uint32_t e = expected.toBits();
+        bool ok = bits.compare_exchange_weak(e, desired.toBits(), order);
+        expected = Float24::fromBits(e);
+        return ok;
+    }
+    bool inline compare_exchange_strong(Float24 &expected, Float24 desired, std::memory_order order = std::memory_order_seq_cst)
+    {
+        uint32_t e = expected.toBits();
+        bool ok = bits.compare_exchange_strong(e, desired.toBits(), order);
+        expected = Float24::fromBits(e);
+        return ok;
+    }
+
+    Float24 inline fetch_add(Float24 arg, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return update([&](Float24 old) { return old + arg; }, order);
+    }
+    Float24 inline fetch_sub(Float24 arg, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return update([&](Float24 old) { return old - arg; }, order);
+    }
+    /** NaN 参数不会写入；当前值为 NaN 时保持不变；值不变时不写入 */
+    Float24 inline fetch_min(Float24 arg, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return updateIfChanged([&](Float24 old) { return arg.toFloat() < old.toFloat() ? arg : old; }, order);
+    }
+    Float24 inline fetch_max(Float24 arg, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return updateIfChanged([&](Float24 old) { return arg.toFloat() > old.toFloat() ? arg : old; }, order);
+    }
+
+    operator Float24() const { return load(); }
+    Float24 inline operator=(Float24 value)
+    {
+        store(value);
+        return value;
+    }
+};
+
+#endif
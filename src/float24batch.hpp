@@ -0,0 +1,194 @@
+#ifndef FLOAT24BATCH_HPP
+#define FLOAT24BATCH_HPP
+
+#include <cstddef>
+#include "float24.hpp"
+
+/** 批量内核
+    先扩展为 f32 计算（随机舍入时为 f64），再舍入回 Float24；逐元素无分支，便于编译器向量化
+    结果与逐个使用 Float24 的运算符逐位一致（NaN 的位模式除外）
+    FLOAT24_BACKEND 为软浮点时，向零截断的 float24Add / float24Mul 逐元素调用整数实现
+
+    随机舍入版本使用 rng.at(offset + i) 作为第 i 个元素的随机数，
+    结果只由 (rng, offset) 决定，与线程划分和向量宽度无关 */
+
+static_assert(sizeof(Float24) == 4, "Float24 should occupy one 32-bit word");
+
+/** cond 为 1 时取 a，为 0 时取 b；用位运算代替分支，以便编译器向量化 */
+inline uint32_t float24Select(uint32_t cond, uint32_t a, uint32_t b)
+{
+    uint32_t mask = 0U - cond;
+    return (a & mask) | (b & ~mask);
+}
+
+/** 按 32 位字读写 Float24 数组，等价于 toBits / fromBits
+    Float24 在内存中为 sign_exponent, 填充字节, mantissa，小端下可整字读写 */
+inline uint32_t float24Load(const Float24 *p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint32_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return ((word & 0xFF) << 16) | (word >> 16);
+#else
+    return p->toBits();
+#endif
+}
+inline void float24Store(Float24 *p, uint32_t bits)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint32_t word = (bits >> 16) | (bits << 16);
+    std::memcpy(static_cast<void *>(p), &word, sizeof(word));
+#else
+    *p = Float24::fromBits(bits);
+#endif
+}
+
+/** f32 -> Float24 位表示，向零截断，与 Float24::truncate 一致 */
+inline uint32_t float24BitsFromFloat(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 31) << 23;
+    uint32_t exponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+    int32_t new_exponent = static_cast<int32_t>(exponent) - 127 + 63;
+
+    uint32_t r = (static_cast<uint32_t>(new_exponent) << 16) | (mantissa >> 7);
+    r = float24Select(new_exponent >= 127, 127U << 16, r);                                     // 上溢为 Infinity
+    r = float24Select(new_exponent <= 0, 0, r);                                                 // 下溢为 0
+    r = float24Select(exponent == 0xFF, (127U << 16) | ((0U - (mantissa != 0)) & 0xFFFF), r); // NaN or Infinity
+    return sign | r;
+}
+
+/** f32 -> Float24 位表示，随机舍入，与 Float24::stochastic 一致 */
+inline uint32_t float24BitsFromFloat(float value, uint32_t random)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits += float24Select(((bits >> 23) & 0xFF) != 0xFF, random & 0x7F, 0);
+    std::memcpy(&value, &bits, sizeof(value));
+    return float24BitsFromFloat(value);
+}
+
+/** f64 -> Float24 位表示，随机舍入，与 Float24::stochastic(double, uint32_t) 一致 */
+inline uint32_t float24BitsFromDouble(double value, uint32_t random)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint64_t finite = 0ULL - (((bits >> 52) & 0x7FF) != 0x7FF);
+    bits += (static_cast<uint64_t>(random) << (52 - 16 - 32)) & finite;
+    bits &= ~(((1ULL << (52 - 23)) - 1) & finite);
+    std::memcpy(&value, &bits, sizeof(value));
+    return float24BitsFromFloat(static_cast<float>(value));
+}
+
+/** Float24 位表示 -> f32，与 Float24::toFloat 一致 */
+inline float float24BitsToFloat(uint32_t bits)
+{
+    const float denormal_scale = 1.0f / 4611686018427387904.0f / 65536.0f; // 2^-62 * 2^-16
+    uint32_t sign = (bits >> 23) << 31;
+    uint32_t exponent = (bits >> 16) & 0x7F;
+    uint32_t mantissa = bits & 0xFFFF;
+
+    uint32_t r = ((exponent + 127 - 63) << 23) | (mantissa << 7);
+    r = float24Select(exponent == 127, (0xFFU << 23) | ((0U - (mantissa != 0)) & 0x7FFFFF), r);
+
+    float denormal = static_cast<float>(static_cast<int32_t>(mantissa)) * denormal_scale; // 精确，含 0
+    uint32_t denormal_bits;
+    std::memcpy(&denormal_bits, &denormal, sizeof(denormal_bits));
+    r = float24Select(exponent == 0, denormal_bits, r);
+
+    r |= sign;
+    float value;
+    std::memcpy(&value, &r, sizeof(value));
+    return value;
+}
+
+inline void float24FromFloats(const float *in, Float24 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        float24Store(out + i, float24BitsFromFloat(in[i]));
+}
+inline void float24FromFloats(const float *in, Float24 *out, size_t n, const Float24Rng &rng, uint64_t offset)
+{
+    for (size_t i = 0; i < n; i++)
+        float24Store(out + i, float24BitsFromFloat(in[i], rng.at(offset + i)));
+}
+
+inline void float24ToFloats(const Float24 *in, float *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = float24BitsToFloat(float24Load(in + i));
+}
+
+/** out[i] = a[i] + b[i] */
+inline void float24Add(const Float24 *a, const Float24 *b, Float24 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+#if FLOAT24_BACKEND == FLOAT24_BACKEND_SOFT
+        float24Store(out + i, float24SoftAdd(float24Load(a + i), float24Load(b + i)));
+#else
+        float24Store(out + i, float24BitsFromFloat(float24BitsToFloat(float24Load(a + i)) + float24BitsToFloat(float24Load(b + i))));
+#endif
+}
+inline void float24Add(const Float24 *a, const Float24 *b, Float24 *out, size_t n, const Float24Rng &rng, uint64_t offset)
+{
+    for (size_t i = 0; i < n; i++)
+        float24Store(out + i, float24BitsFromDouble(static_cast<double>(float24BitsToFloat(float24Load(a + i))) + float24BitsToFloat(float24Load(b + i)), rng.at(offset + i)));
+}
+
+/** out[i] = a[i] * b[i] */
+inline void float24Mul(const Float24 *a, const Float24 *b, Float24 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+#if FLOAT24_BACKEND == FLOAT24_BACKEND_SOFT
+        float24Store(out + i, float24SoftMul(float24Load(a + i), float24Load(b + i)));
+#else
+        float24Store(out + i, float24BitsFromFloat(float24BitsToFloat(float24Load(a + i)) * float24BitsToFloat(float24Load(b + i))));
+#endif
+}
+inline void float24Mul(const Float24 *a, const Float24 *b, Float24 *out, size_t n, const Float24Rng &rng, uint64_t offset)
+{
+    for (size_t i = 0; i < n; i++)
+        float24Store(out + i, float24BitsFromDouble(static_cast<double>(float24BitsToFloat(float24Load(a + i))) * float24BitsToFloat(float24Load(b + i)), rng.at(offset + i)));
+}
+
+/** acc[i] += x[i]，用于优化器状态与滑动统计量的原地累加 */
+inline void float24Accumulate(Float24 *acc, const Float24 *x, size_t n)
+{
+    float24Add(acc, x, acc, n);
+}
+inline void float24Accumulate(Float24 *acc, const Float24 *x, size_t n, const Float24Rng &rng, uint64_t offset)
+{
+    float24Add(acc, x, acc, n, rng, offset);
+}
+
+/** FIR 内核，在已扩展为 f32 的采样上计算：out[j] = Σ taps[k] * x[j * step + k]
+    taps 为时间反序的系数，x 至少有 (n - 1) * step + ntaps 个元素
+    按系数外层、输出内层累加，内层循环连续访存，且每个输出的求和顺序与向量宽度无关 */
+inline void float24Fir(const float *x, const float *taps, size_t ntaps, float *out, size_t n)
+{
+    for (size_t j = 0; j < n; j++)
+        out[j] = 0.0f;
+    for (size_t k = 0; k < ntaps; k++)
+    {
+        const float tap = taps[k];
+        const float *xk = x + k;
+        for (size_t j = 0; j < n; j++)
+            out[j] += tap * xk[j];
+    }
+}
+inline void float24FirDecimate(const float *x, const float *taps, size_t ntaps, size_t step, float *out, size_t n)
+{
+    for (size_t j = 0; j < n; j++)
+        out[j] = 0.0f;
+    for (size_t k = 0; k < ntaps; k++)
+    {
+        const float tap = taps[k];
+        const float *xk = x + k;
+        for (size_t j = 0; j < n; j++)
+            out[j] += tap * xk[j * step];
+    }
+}
+
+#endif
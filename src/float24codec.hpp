@@ -0,0 +1,307 @@
+#ifndef FLOAT24CODEC_HPP
+#define FLOAT24CODEC_HPP
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "float24.hpp"
+
+/** 残差：XOR 适合常有重复值或量化过的序列，Delta 适合带噪声的缓变序列 */
+enum class Float24Residual : uint8_t
+{
+    Xor,   // 与前值的 24 位表示异或
+    Delta, // 与前值保序键（Float24::toOrderKey）之差，zigzag 编码
+};
+
+/** Float24 时间序列的 XOR/Delta 流式压缩（Gorilla 风格）
+    每个值与前一个值求残差（见 Float24Residual），按前导零与末尾零编码：
+        0                                   与前值相同
+        10 <有效位>                          有效位落在上一个窗口内，沿用窗口
+        11 <前导零 5 位> <长度-1 5 位> <有效位> 新窗口
+    缓变信号的符号阶码字节通常不变，异或结果前导零 >= 8，一般只需写尾数中变化的几位
+
+    数据按 chunk_size 个值分块，每块首值原样写 24 位且按字节对齐，
+    记录每块的字节偏移，因此可以随机访问单个块，也可以按块并行解码 */
+struct Float24XorStream
+{
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> chunk_offsets; // 每块在 bytes 中的起始位置
+    size_t count = 0;                  // 值的个数
+    size_t chunk_size = 0;
+    Float24Residual residual = Float24Residual::Xor;
+
+    /** 残差与其逆变换，均在 24 位内 */
+    uint32_t inline encodeResidual(uint32_t prev, uint32_t bits) const
+    {
+        if (residual == Float24Residual::Xor)
+            return bits ^ prev;
+        int32_t d = static_cast<int32_t>((Float24::bitsToOrderKey(bits) - Float24::bitsToOrderKey(prev)) << 8) >> 8; // 24 位有符号差
+        return ((static_cast<uint32_t>(d) << 1) ^ static_cast<uint32_t>(d >> 31)) & 0xFFFFFF;
+    }
+    uint32_t inline decodeResidual(uint32_t prev, uint32_t r) const
+    {
+        if (residual == Float24Residual::Xor)
+            return prev ^ r;
+        uint32_t d = (r >> 1) ^ (0U - (r & 1)); // zigzag 逆变换
+        return Float24::orderKeyToBits((Float24::bitsToOrderKey(prev) + d) & 0xFFFFFF);
+    }
+
+    size_t inline chunkCount() const { return chunk_offsets.size(); }
+    /** @return 第 chunk 块中值的个数 */
+    size_t inline chunkLength(size_t chunk) const
+    {
+        size_t begin = chunk * chunk_size;
+        return count - begin < chunk_size ? count - begin : chunk_size;
+    }
+};
+
+class Float24XorEncoder
+{
+private:
+    Float24XorStream stream;
+    uint64_t acc = 0;   // 待写出的位
+    unsigned nbits = 0; // acc 中有效位数，始终 < 8
+    uint32_t prev = 0;
+    unsigned prev_lead = 0;
+    unsigned prev_trail = 0;
+    size_t in_chunk = 0;
+    bool finished = false;
+
+    /** 写入 bits 位，bits <= 24 */
+    void inline write(uint32_t value, unsigned bits)
+    {
+        acc = (acc << bits) | value;
+        nbits += bits;
+        while (nbits >= 8)
+        {
+            nbits -= 8;
+            stream.bytes.push_back(static_cast<uint8_t>(acc >> nbits));
+        }
+    }
+    void inline alignByte()
+    {
+        if (nbits)
+            stream.bytes.push_back(static_cast<uint8_t>(acc << (8 - nbits)));
+        acc = 0;
+        nbits = 0;
+    }
+
+public:
+    explicit Float24XorEncoder(size_t chunk_size = 1024, Float24Residual residual = Float24Residual::Xor)
+    {
+        if (chunk_size == 0)
+            throw std::invalid_argument("chunk_size should be positive");
+        stream.chunk_size = chunk_size;
+        stream.residual = residual;
+    }
+
+    void push(Float24 value)
+    {
+        if (finished)
+            throw std::logic_error("encoder already finished");
+        uint32_t bits = value.toBits();
+        if (in_chunk == stream.chunk_size)
+            in_chunk = 0;
+        if (in_chunk == 0)
+        { // 新块
+            alignByte();
+            stream.chunk_offsets.push_back(stream.bytes.size());
+            write(bits, 24);
+            prev_lead = 24; // 使下一个非零异或必然开新窗口
+            prev_trail = 0;
+        }
+        else
+        {
+            uint32_t x = stream.encodeResidual(prev, bits);
+            if (x == 0)
+                write(0, 1);
+            else
+            {
+                unsigned lead = __builtin_clz(x) - 8;
+                unsigned trail = __builtin_ctz(x);
+                if (lead >= prev_lead && trail >= prev_trail)
+                {
+                    write(0b10, 2);
+                    write(x >> prev_trail, 24 - prev_lead - prev_trail);
+                }
+                else
+                {
+                    unsigned length = 24 - lead - trail;
+                    write(0b11, 2);
+                    write((lead << 5) | (length - 1), 10);
+                    write(x >> trail, length);
+                    prev_lead = lead;
+                    prev_trail = trail;
+                }
+            }
+        }
+        prev = bits;
+        in_chunk++;
+        stream.count++;
+        if (in_chunk == stream.chunk_size)
+            alignByte(); // 块写满即按字节对齐，使其可以立即被 drain 取走
+    }
+    void push(const Float24 *values, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            push(values[i]);
+    }
+
+    /** @return 已写满、尚未被 drain 取走的块数 */
+    size_t inline completedChunks() const
+    {
+        return in_chunk == stream.chunk_size ? stream.chunkCount() : stream.chunkCount() - (in_chunk ? 1 : 0);
+    }
+
+    /** 取走所有已写满的块，作为一段独立的压缩流返回，并从编码器中释放
+        各段可分别解码，依次拼接即为原序列；编码器只保留正在写的块 */
+    Float24XorStream drain()
+    {
+        Float24XorStream out;
+        out.chunk_size = stream.chunk_size;
+        out.residual = stream.residual;
+        size_t chunks = completedChunks();
+        if (chunks == 0)
+            return out;
+        size_t end = chunks < stream.chunkCount() ? stream.chunk_offsets[chunks] : stream.bytes.size();
+        out.bytes.assign(stream.bytes.begin(), stream.bytes.begin() + end);
+        out.chunk_offsets.assign(stream.chunk_offsets.begin(), stream.chunk_offsets.begin() + chunks);
+        out.count = chunks * stream.chunk_size;
+
+        stream.bytes.erase(stream.bytes.begin(), stream.bytes.begin() + end);
+        stream.chunk_offsets.erase(stream.chunk_offsets.begin(), stream.chunk_offsets.begin() + chunks);
+        for (size_t &offset : stream.chunk_offsets)
+            offset -= end;
+        stream.count -= out.count;
+        return out;
+    }
+
+    /** 写出未满一字节的位，返回尚未被 drain 取走的压缩结果；之后不能再 push */
+    const Float24XorStream &finish()
+    {
+        alignByte();
+        finished = true;
+        return stream;
+    }
+};
+
+class Float24XorDecoder
+{
+private:
+    /** 单块解码状态 */
+    struct Cursor
+    {
+        const Float24XorStream *stream;
+        const uint8_t *pos;
+        const uint8_t *end;
+        uint64_t buf = 0;
+        unsigned avail = 0; // buf 中未读位数
+        uint32_t prev = 0;
+        unsigned lead = 0;
+        unsigned trail = 0;
+        bool first = true;
+
+        Cursor(const Float24XorStream *stream, const uint8_t *pos, const uint8_t *end)
+            : stream(stream), pos(pos), end(end) {}
+
+        /** 读取 bits 位，bits <= 24；越过末尾补 0 */
+        uint32_t inline read(unsigned bits)
+        {
+            while (avail <= 56)
+            {
+                buf = (buf << 8) | (pos < end ? *pos++ : 0);
+                avail += 8;
+            }
+            avail -= bits;
+            return static_cast<uint32_t>(buf >> avail) & ((1U << bits) - 1);
+        }
+        uint32_t inline next()
+        {
+            if (first)
+            {
+                first = false;
+                prev = read(24);
+            }
+            else if (read(1))
+            {
+                if (read(1))
+                {
+                    uint32_t header = read(10);
+                    lead = header >> 5;
+                    trail = 24 - lead - ((header & 0b11111) + 1);
+                }
+                prev = stream->decodeResidual(prev, read(24 - lead - trail) << trail);
+            }
+            return prev;
+        }
+    };
+
+    std::shared_ptr<const Float24XorStream> owned; // 由临时流构造时持有它
+    const Float24XorStream *stream;
+    Cursor cursor;
+    size_t index = 0;
+
+    Cursor inline chunkCursor(size_t chunk) const
+    {
+        const uint8_t *data = stream->bytes.data();
+        size_t end = chunk + 1 < stream->chunkCount() ? stream->chunk_offsets[chunk + 1] : stream->bytes.size();
+        return Cursor(stream, data + stream->chunk_offsets[chunk], data + end);
+    }
+
+public:
+    /** 引用 stream，解码器使用期间 stream 必须存活 */
+    explicit Float24XorDecoder(const Float24XorStream &stream)
+        : stream(&stream), cursor(&stream, nullptr, nullptr) {}
+    /** 接管临时的 stream，如 Float24XorDecoder(encoder.drain()) */
+    explicit Float24XorDecoder(Float24XorStream &&stream)
+        : owned(std::make_shared<const Float24XorStream>(std::move(stream))), stream(owned.get()),
+          cursor(this->stream, nullptr, nullptr) {}
+
+    size_t inline size() const { return stream->count; }
+
+    /** 流式读取下一个值，读完返回 false */
+    bool next(Float24 &out)
+    {
+        if (index >= stream->count)
+            return false;
+        if (index % stream->chunk_size == 0)
+            cursor = chunkCursor(index / stream->chunk_size);
+        out = Float24::fromBits(cursor.next());
+        index++;
+        return true;
+    }
+    /** 回到开头 */
+    void inline rewind() { index = 0; }
+
+    /** 解码第 chunk 块到 out，out 至少有 chunkLength(chunk) 个元素 */
+    void decodeChunk(size_t chunk, Float24 *out) const
+    {
+        if (chunk >= stream->chunkCount())
+            throw std::out_of_range("chunk index out of range");
+        Cursor c = chunkCursor(chunk);
+        size_t n = stream->chunkLength(chunk);
+        for (size_t i = 0; i < n; i++)
+            out[i] = Float24::fromBits(c.next());
+    }
+    /** 批量解码全部值到 out，out 至少有 size() 个元素 */
+    void decodeAll(Float24 *out) const
+    {
+        for (size_t chunk = 0; chunk < stream->chunkCount(); chunk++)
+            decodeChunk(chunk, out + chunk * stream->chunk_size);
+    }
+    /** 随机访问第 i 个值，只解码其所在块的前缀 */
+    Float24 at(size_t i) const
+    {
+        if (i >= stream->count)
+            throw std::out_of_range("index out of range");
+        Cursor c = chunkCursor(i / stream->chunk_size);
+        uint32_t bits = 0;
+        for (size_t k = 0; k <= i % stream->chunk_size; k++)
+            bits = c.next();
+        return Float24::fromBits(bits);
+    }
+};
+
+#endif
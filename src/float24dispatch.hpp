@@ -0,0 +1,217 @@
+#ifndef FLOAT24DISPATCH_HPP
+#define FLOAT24DISPATCH_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "float24batch.hpp"
+#include "float24pcm.hpp"
+
+/** 运行时按 CPU 指令集分派批量内核
+    同一份内核源码以不同的 target 属性编译为多个版本，启动后第一次调用时按 CPUID 选择一次，
+    因此可用不带 -march 的编译选项发布单个二进制
+
+    环境变量 FLOAT24_ISA=scalar|sse4.2|avx2|avx512 可强制指定级别（用于测试），
+    高于 CPU 实际支持的级别会被降到支持的最高级别
+    除 NaN 结果的符号位外，各级别结果逐位一致（编译时需 -ffp-contract=off，避免部分级别把乘加融合为 FMA） */
+enum class Float24Isa : uint8_t
+{
+    Scalar,
+    SSE42,
+    AVX2,
+    AVX512,
+};
+
+/** 一组批量内核，语义与 float24batch.hpp、float24pcm.hpp 中的同名函数一致 */
+struct Float24Kernels
+{
+    Float24Isa isa;
+    void (*fromFloats)(const float *in, Float24 *out, size_t n);
+    void (*fromFloatsStochastic)(const float *in, Float24 *out, size_t n, const Float24Rng &rng, uint64_t offset);
+    void (*toFloats)(const Float24 *in, float *out, size_t n);
+    void (*add)(const Float24 *a, const Float24 *b, Float24 *out, size_t n);
+    void (*addStochastic)(const Float24 *a, const Float24 *b, Float24 *out, size_t n, const Float24Rng &rng, uint64_t offset);
+    void (*mul)(const Float24 *a, const Float24 *b, Float24 *out, size_t n);
+    void (*mulStochastic)(const Float24 *a, const Float24 *b, Float24 *out, size_t n, const Float24Rng &rng, uint64_t offset);
+    void (*fromPcm16)(const int16_t *in, Float24 *out, size_t n, float scale);
+    void (*toPcm16)(const Float24 *in, int16_t *out, size_t n, float scale);
+    void (*fromPcm24)(const uint8_t *in, Float24 *out, size_t n, float scale);
+    void (*toPcm24)(const Float24 *in, uint8_t *out, size_t n, float scale);
+    void (*fromInt32)(const int32_t *in, Float24 *out, size_t n, float scale);
+    void (*toInt32)(const Float24 *in, int32_t *out, size_t n, float scale);
+    void (*fir)(const float *x, const float *taps, size_t ntaps, float *out, size_t n);
+    void (*firDecimate)(const float *x, const float *taps, size_t ntaps, size_t step, float *out, size_t n);
+};
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FLOAT24_DISPATCH_X86 1
+#endif
+
+// 以 target 属性编译一组内核，内核体内联自 float24batch.hpp、float24pcm.hpp
+#define FLOAT24_DEFINE_KERNELS(suffix, attribute)                                                                               \
+    attribute inline void float24FromFloats_##suffix(const float *in, Float24 *out, size_t n)                                   \
+    {                                                                                                                           \
+        float24FromFloats(in, out, n);                                                                                          \
+    }                                                                                                                           \
+    attribute inline void float24FromFloatsStochastic_##suffix(const float *in, Float24 *out, size_t n, const Float24Rng &rng,  \
+                                                              uint64_t offset)                                                  \
+    {                                                                                                                           \
+        float24FromFloats(in, out, n, rng, offset);                                                                             \
+    }                                                                                                                           \
+    attribute inline void float24ToFloats_##suffix(const Float24 *in, float *out, size_t n)                                     \
+    {                                                                                                                           \
+        float24ToFloats(in, out, n);                                                                                            \
+    }                                                                                                                           \
+    attribute inline void float24Add_##suffix(const Float24 *a, const Float24 *b, Float24 *out, size_t n)                       \
+    {                                                                                                                           \
+        float24Add(a, b, out, n);                                                                                               \
+    }                                                                                                                           \
+    attribute inline void float24AddStochastic_##suffix(const Float24 *a, const Float24 *b, Float24 *out, size_t n,             \
+                                                       const Float24Rng &rng, uint64_t offset)                                  \
+    {                                                                                                                           \
+        float24Add(a, b, out, n, rng, offset);                                                                                  \
+    }                                                                                                                           \
+    attribute inline void float24Mul_##suffix(const Float24 *a, const Float24 *b, Float24 *out, size_t n)                       \
+    {                                                                                                                           \
+        float24Mul(a, b, out, n);                                                                                               \
+    }                                                                                                                           \
+    attribute inline void float24MulStochastic_##suffix(const Float24 *a, const Float24 *b, Float24 *out, size_t n,             \
+                                                       const Float24Rng &rng, uint64_t offset)                                  \
+    {                                                                                                                           \
+        float24Mul(a, b, out, n, rng, offset);                                                                                  \
+    }                                                                                                                           \
+    attribute inline void float24FromPcm16_##suffix(const int16_t *in, Float24 *out, size_t n, float scale)                     \
+    {                                                                                                                           \
+        float24FromPcm16(in, out, n, scale);                                                                                    \
+    }                                                                                                                           \
+    attribute inline void float24ToPcm16_##suffix(const Float24 *in, int16_t *out, size_t n, float scale)                       \
+    {                                                                                                                           \
+        float24ToPcm16(in, out, n, scale);                                                                                      \
+    }                                                                                                                           \
+    attribute inline void float24FromPcm24_##suffix(const uint8_t *in, Float24 *out, size_t n, float scale)                     \
+    {                                                                                                                           \
+        float24FromPcm24(in, out, n, scale);                                                                                    \
+    }                                                                                                                           \
+    attribute inline void float24ToPcm24_##suffix(const Float24 *in, uint8_t *out, size_t n, float scale)                       \
+    {                                                                                                                           \
+        float24ToPcm24(in, out, n, scale);                                                                                      \
+    }                                                                                                                           \
+    attribute inline void float24FromInt32_##suffix(const int32_t *in, Float24 *out, size_t n, float scale)                     \
+    {                                                                                                                           \
+        float24FromInt32(in, out, n, scale);                                                                                    \
+    }                                                                                                                           \
+    attribute inline void float24ToInt32_##suffix(const Float24 *in, int32_t *out, size_t n, float scale)                       \
+    {                                                                                                                           \
+        float24ToInt32(in, out, n, scale);                                                                                      \
+    }                                                                                                                           \
+    attribute inline void float24Fir_##suffix(const float *x, const float *taps, size_t ntaps, float *out, size_t n)            \
+    {                                                                                                                           \
+        float24Fir(x, taps, ntaps, out, n);                                                                                     \
+    }                                                                                                                           \
+    attribute inline void float24FirDecimate_##suffix(const float *x, const float *taps, size_t ntaps, size_t step, float *out, \
+                                                     size_t n)                                                                  \
+    {                                                                                                                           \
+        float24FirDecimate(x, taps, ntaps, step, out, n);                                                                       \
+    }
+
+#define FLOAT24_KERNEL_TABLE(isa, suffix)                                                                                      \
+    {                                                                                                                           \
+        isa, float24FromFloats_##suffix, float24FromFloatsStochastic_##suffix, float24ToFloats_##suffix, float24Add_##suffix, \
+            float24AddStochastic_##suffix, float24Mul_##suffix, float24MulStochastic_##suffix, float24FromPcm16_##suffix,     \
+            float24ToPcm16_##suffix, float24FromPcm24_##suffix, float24ToPcm24_##suffix, float24FromInt32_##suffix,           \
+            float24ToInt32_##suffix, float24Fir_##suffix, float24FirDecimate_##suffix                                         \
+    }
+
+FLOAT24_DEFINE_KERNELS(scalar, )
+#ifdef FLOAT24_DISPATCH_X86
+FLOAT24_DEFINE_KERNELS(sse42, __attribute__((target("sse4.2"))))
+FLOAT24_DEFINE_KERNELS(avx2, __attribute__((target("avx2"))))
+FLOAT24_DEFINE_KERNELS(avx512, __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"))))
+#endif
+
+/** @return CPU 支持的最高级别 */
+inline Float24Isa float24DetectIsa()
+{
+#ifdef FLOAT24_DISPATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+        return Float24Isa::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return Float24Isa::AVX2;
+    if (__builtin_cpu_supports("sse4.2"))
+        return Float24Isa::SSE42;
+#endif
+    return Float24Isa::Scalar;
+}
+
+/** 解析 FLOAT24_ISA 的取值，无法识别时抛出异常 */
+inline Float24Isa float24ParseIsa(const char *name)
+{
+    if (std::strcmp(name, "scalar") == 0)
+        return Float24Isa::Scalar;
+    if (std::strcmp(name, "sse4.2") == 0)
+        return Float24Isa::SSE42;
+    if (std::strcmp(name, "avx2") == 0)
+        return Float24Isa::AVX2;
+    if (std::strcmp(name, "avx512") == 0)
+        return Float24Isa::AVX512;
+    throw std::invalid_argument(std::string("unknown FLOAT24_ISA '") + name + "'");
+}
+
+inline const char *float24IsaName(Float24Isa isa)
+{
+    switch (isa)
+    {
+    case Float24Isa::SSE42:
+        return "sse4.2";
+    case Float24Isa::AVX2:
+        return "avx2";
+    case Float24Isa::AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+/** @return 指定级别的内核，高于 CPU 支持的级别时降级 */
+inline const Float24Kernels &float24Kernels(Float24Isa isa)
+{
+    static const Float24Kernels scalar = FLOAT24_KERNEL_TABLE(Float24Isa::Scalar, scalar);
+#ifdef FLOAT24_DISPATCH_X86
+    static const Float24Kernels sse42 = FLOAT24_KERNEL_TABLE(Float24Isa::SSE42, sse42);
+    static const Float24Kernels avx2 = FLOAT24_KERNEL_TABLE(Float24Isa::AVX2, avx2);
+    static const Float24Kernels avx512 = FLOAT24_KERNEL_TABLE(Float24Isa::AVX512, avx512);
+
+    static const Float24Isa supported = float24DetectIsa();
+    if (isa > supported)
+        isa = supported;
+    switch (isa)
+    {
+    case Float24Isa::SSE42:
+        return sse42;
+    case Float24Isa::AVX2:
+        return avx2;
+    case Float24Isa::AVX512:
+        return avx512;
+    default:
+        break;
+    }
+#endif
+    (void)isa;
+    return scalar;
+}
+
+/** @return 本机选定的内核，第一次调用时检测 CPU 与 FLOAT24_ISA */
+inline const Float24Kernels &float24Kernels()
+{
+    static const Float24Kernels &selected = []() -> const Float24Kernels &
+    {
+        const char *forced = std::getenv("FLOAT24_ISA");
+        return float24Kernels(forced && *forced ? float24ParseIsa(forced) : float24DetectIsa());
+    }();
+    return selected;
+}
+
+#endif
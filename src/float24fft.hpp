@@ -0,0 +1,238 @@
+#ifndef FLOAT24FFT_HPP
+#define FLOAT24FFT_HPP
+
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "float24batch.hpp"
+
+/** Float24 复数，交错布局：re, im 相邻存放
+    运算扩展为 f32 计算后再舍入，舍入方式见 Float24::rounding() */
+struct Complex24
+{
+    Float24 re;
+    Float24 im;
+
+    Complex24() : re(), im() {}
+    Complex24(Float24 re, Float24 im) : re(re), im(im) {}
+    explicit Complex24(std::complex<float> z) : re(z.real()), im(z.imag()) {}
+
+    std::complex<float> inline toComplex() const { return std::complex<float>(re.toFloat(), im.toFloat()); }
+    Complex24 inline conj() const
+    {
+        Float24 neg = im.clone();
+        neg.setSign(!im.getSign());
+        return Complex24(re, neg);
+    }
+
+    Complex24 operator+(const Complex24 &other) const { return Complex24(toComplex() + other.toComplex()); }
+    Complex24 operator-(const Complex24 &other) const { return Complex24(toComplex() - other.toComplex()); }
+    Complex24 operator*(const Complex24 &other) const { return Complex24(toComplex() * other.toComplex()); }
+};
+
+/** 分离布局：实部与虚部各为一个连续数组 */
+struct Complex24Split
+{
+    Float24 *re;
+    Float24 *im;
+};
+
+/** 原地 FFT，长度为 2 的幂
+    位反序后先做一级基 2（log2 n 为奇数时），其余为基 4，每级读写一次 Float24 数据，
+    蝶形在 f32 中计算，写回时就近舍入，因此不需要 f32 的临时缓冲区
+    旋转因子表以 Float24 预先计算
+    正变换 X[k] = Σ x[j] e^{-2πijk/n}，逆变换带 1/n 缩放 */
+class Float24Fft
+{
+private:
+    size_t n;
+    unsigned log2n = 0;
+    std::vector<Complex24> twiddles; // e^{-2πij/n}，j < 3n/4
+
+    struct Interleaved
+    {
+        Complex24 *data;
+        Float24 &re(size_t i) const { return data[i].re; }
+        Float24 &im(size_t i) const { return data[i].im; }
+    };
+    struct Split
+    {
+        Complex24Split data;
+        Float24 &re(size_t i) const { return data.re[i]; }
+        Float24 &im(size_t i) const { return data.im[i]; }
+    };
+
+    /** 蝶形中几乎都是规格化数，先走可预测的快速分支，其余情况交给通用转换 */
+    static float inline load(const Float24 &f)
+    {
+        uint32_t bits = f.toBits();
+        uint32_t exponent = (bits >> 16) & 0x7F;
+        if (exponent - 1 < 126)
+        {
+            uint32_t r = ((bits >> 23) << 31) | ((exponent + 127 - 63) << 23) | ((bits & 0xFFFF) << 7);
+            float value;
+            std::memcpy(&value, &r, sizeof(value));
+            return value;
+        }
+        return float24BitsToFloat(bits);
+    }
+    /** 就近舍入：随机舍入的随机数固定为半个末位 */
+    static Float24 inline round(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint32_t exponent = (bits >> 23) & 0xFF;
+        if (exponent - (127 - 63 + 1) < 126 - 1) // 进位后仍不会上溢
+        {
+            bits += 0x40;
+            exponent = (bits >> 23) & 0xFF;
+            return Float24::fromBits(((bits >> 31) << 23) | ((exponent - 127 + 63) << 16) | ((bits >> 7) & 0xFFFF));
+        }
+        return Float24::fromBits(float24BitsFromFloat(value, 0x40));
+    }
+
+    template <typename Access>
+    void transform(Access a, bool inverse) const
+    {
+        // 位反序
+        for (size_t i = 1, j = 0; i < n; i++)
+        {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j |= bit;
+            if (i < j)
+            {
+                std::swap(a.re(i), a.re(j));
+                std::swap(a.im(i), a.im(j));
+            }
+        }
+
+        const float sign = inverse ? 1.0f : -1.0f; // 旋转方向
+        const float conj = inverse ? -1.0f : 1.0f;  // 逆变换使用共轭旋转因子
+        unsigned stages_left = log2n;
+        size_t length = 1;
+        float scale = 1.0f;
+        if (log2n & 1)
+        { // 基 2
+            scale = inverse && stages_left == 1 ? 1.0f / n : 1.0f;
+            for (size_t i = 0; i < n; i += 2)
+            {
+                float ar = load(a.re(i)), ai = load(a.im(i));
+                float br = load(a.re(i + 1)), bi = load(a.im(i + 1));
+                a.re(i) = round((ar + br) * scale);
+                a.im(i) = round((ai + bi) * scale);
+                a.re(i + 1) = round((ar - br) * scale);
+                a.im(i + 1) = round((ai - bi) * scale);
+            }
+            stages_left--;
+            length = 2;
+        }
+        for (; stages_left; stages_left -= 2, length *= 4)
+        { // 基 4：合并 4 个长度为 length 的子变换
+            scale = inverse && stages_left == 2 ? 1.0f / n : 1.0f;
+            size_t step = n / (4 * length);
+            for (size_t k = 0; k < length; k++)
+            { // 同一组旋转因子用于所有分组，只转换一次
+                const Complex24 &tw1 = twiddles[k * step];
+                const Complex24 &tw2 = twiddles[2 * k * step];
+                const Complex24 &tw3 = twiddles[3 * k * step];
+                float w1r = load(tw1.re), w1i = conj * load(tw1.im);
+                float w2r = load(tw2.re), w2i = conj * load(tw2.im);
+                float w3r = load(tw3.re), w3i = conj * load(tw3.im);
+                for (size_t base = 0; base < n; base += 4 * length)
+                {
+                    size_t i0 = base + k, i1 = i0 + length, i2 = i1 + length, i3 = i2 + length;
+
+                    // 位反序下 4 个子块依次为 x[4m], x[4m+2], x[4m+1], x[4m+3] 的变换
+                    float ar = load(a.re(i0)), ai = load(a.im(i0));
+                    float cr0 = load(a.re(i1)), ci0 = load(a.im(i1));
+                    float br0 = load(a.re(i2)), bi0 = load(a.im(i2));
+                    float dr0 = load(a.re(i3)), di0 = load(a.im(i3));
+                    float br = br0 * w1r - bi0 * w1i, bi = br0 * w1i + bi0 * w1r;
+                    float cr = cr0 * w2r - ci0 * w2i, ci = cr0 * w2i + ci0 * w2r;
+                    float dr = dr0 * w3r - di0 * w3i, di = dr0 * w3i + di0 * w3r;
+
+                    float t0r = ar + cr, t0i = ai + ci;
+                    float t1r = ar - cr, t1i = ai - ci;
+                    float t2r = br + dr, t2i = bi + di;
+                    float t3r = br - dr, t3i = bi - di;
+                    // sign * i * t3
+                    float ur = -sign * t3i, ui = sign * t3r;
+
+                    a.re(i0) = round((t0r + t2r) * scale);
+                    a.im(i0) = round((t0i + t2i) * scale);
+                    a.re(i1) = round((t1r + ur) * scale);
+                    a.im(i1) = round((t1i + ui) * scale);
+                    a.re(i2) = round((t0r - t2r) * scale);
+                    a.im(i2) = round((t0i - t2i) * scale);
+                    a.re(i3) = round((t1r - ur) * scale);
+                    a.im(i3) = round((t1i - ui) * scale);
+                }
+            }
+        }
+    }
+
+    template <typename Job>
+    static void parallel(size_t count, unsigned threads, Job job)
+    {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        if (threads > count)
+            threads = static_cast<unsigned>(count);
+        std::atomic<size_t> next(0);
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count; i = next++)
+                job(i);
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; t++)
+            pool.emplace_back(worker);
+        worker();
+        for (std::thread &t : pool)
+            t.join();
+    }
+
+public:
+    explicit Float24Fft(size_t n) : n(n)
+    {
+        if (n == 0 || (n & (n - 1)))
+            throw std::invalid_argument("FFT size should be a power of 2");
+        while ((size_t(1) << log2n) < n)
+            log2n++;
+        size_t count = 3 * n / 4 ? 3 * n / 4 : 1;
+        twiddles.reserve(count);
+        for (size_t j = 0; j < count; j++)
+        {
+            double angle = -2.0 * std::acos(-1.0) * j / n;
+            twiddles.push_back(Complex24(round(static_cast<float>(std::cos(angle))), round(static_cast<float>(std::sin(angle)))));
+        }
+    }
+
+    size_t inline size() const { return n; }
+
+    void forward(Complex24 *data) const { transform(Interleaved{data}, false); }
+    void inverse(Complex24 *data) const { transform(Interleaved{data}, true); }
+    void forward(Complex24Split data) const { transform(Split{data}, false); }
+    void inverse(Complex24Split data) const { transform(Split{data}, true); }
+
+    /** 对 count 个连续存放、各长 size() 的序列做变换，threads 为 0 时使用全部硬件线程 */
+    void forwardBatch(Complex24 *data, size_t count, unsigned threads = 0) const
+    {
+        parallel(count, threads, [&](size_t i)
+                 { forward(data + i * n); });
+    }
+    void inverseBatch(Complex24 *data, size_t count, unsigned threads = 0) const
+    {
+        parallel(count, threads, [&](size_t i)
+                 { inverse(data + i * n); });
+    }
+};
+
+#endif
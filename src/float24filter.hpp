@@ -0,0 +1,209 @@
+#ifndef FLOAT24FILTER_HPP
+#define FLOAT24FILTER_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "float24dispatch.hpp"
+
+/** Float24 采样流上的流式滤波器
+    按块处理：整块扩展为 f32，在更宽的类型中计算后一次性舍入回 Float24（向零截断），
+    块间保留状态，因此任意切分输入得到的结果相同
+    FIR 类在 f32 中累加并使用分派后的向量化内核；双二阶节为递归结构，状态与中间结果用 f64 */
+
+/** FIR 滤波器：y[n] = Σ h[k] * x[n - k] */
+class Float24Fir
+{
+private:
+    std::vector<float> taps; // 时间反序的系数
+    std::vector<float> work; // 前 taps.size() - 1 个为历史采样，其后为当前块
+    std::vector<float> acc;
+
+public:
+    static const size_t block_size = 1024;
+
+    explicit Float24Fir(const std::vector<float> &coefficients)
+        : taps(coefficients.rbegin(), coefficients.rend()), work(coefficients.size() - 1 + block_size), acc(block_size)
+    {
+        if (coefficients.empty())
+            throw std::invalid_argument("FIR should have at least one tap");
+    }
+
+    /** 处理 n 个采样，out 可以与 in 相同 */
+    void process(const Float24 *in, Float24 *out, size_t n)
+    {
+        const Float24Kernels &kernels = float24Kernels();
+        size_t history = taps.size() - 1;
+        for (size_t done = 0; done < n; done += block_size)
+        {
+            size_t m = n - done < block_size ? n - done : block_size;
+            kernels.toFloats(in + done, work.data() + history, m);
+            kernels.fir(work.data(), taps.data(), taps.size(), acc.data(), m);
+            kernels.fromFloats(acc.data(), out + done, m);
+            std::copy(work.begin() + m, work.begin() + m + history, work.begin());
+        }
+    }
+    /** 清空历史采样 */
+    void reset() { std::fill(work.begin(), work.end(), 0.0f); }
+};
+
+/** 抽取器：FIR 后每 factor 个采样保留一个，输出第一个采样对应输入第一个采样 */
+class Float24Decimator
+{
+private:
+    std::vector<float> taps;
+    std::vector<float> work;
+    std::vector<float> acc;
+    size_t factor;
+    size_t start = 0; // 下一个输出的窗口在 work 中的起点
+
+public:
+    static const size_t block_size = 1024;
+
+    Float24Decimator(const std::vector<float> &coefficients, size_t factor)
+        : taps(coefficients.rbegin(), coefficients.rend()), work(coefficients.size() - 1 + block_size),
+          acc(block_size), factor(factor)
+    {
+        if (coefficients.empty())
+            throw std::invalid_argument("FIR should have at least one tap");
+        if (factor == 0)
+            throw std::invalid_argument("decimation factor should be positive");
+    }
+
+    /** 处理 n 个输入采样，out 至少需要 n / factor + 1 个元素
+        @return 输出的采样数 */
+    size_t process(const Float24 *in, Float24 *out, size_t n)
+    {
+        const Float24Kernels &kernels = float24Kernels();
+        size_t history = taps.size() - 1;
+        size_t produced = 0;
+        for (size_t done = 0; done < n; done += block_size)
+        {
+            size_t m = n - done < block_size ? n - done : block_size;
+            kernels.toFloats(in + done, work.data() + history, m);
+            size_t count = start < m ? (m - 1 - start) / factor + 1 : 0;
+            kernels.firDecimate(work.data() + start, taps.data(), taps.size(), factor, acc.data(), count);
+            kernels.fromFloats(acc.data(), out + produced, count);
+            produced += count;
+            start = start + count * factor - m;
+            std::copy(work.begin() + m, work.begin() + m + history, work.begin());
+        }
+        return produced;
+    }
+    void reset()
+    {
+        std::fill(work.begin(), work.end(), 0.0f);
+        start = 0;
+    }
+};
+
+/** 插值器：每个输入采样后插入 factor - 1 个零再做 FIR，按多相分解只计算非零项
+    输出为输入的 factor 倍，需要单位增益时系数应乘以 factor */
+class Float24Interpolator
+{
+private:
+    std::vector<float> phases; // factor 组子滤波器，每组 length 个时间反序系数
+    size_t length;
+    size_t factor;
+    std::vector<float> work;
+    std::vector<float> acc;   // 各相输出
+    std::vector<float> mixed; // 交错后的输出
+
+public:
+    static const size_t block_size = 1024;
+
+    Float24Interpolator(const std::vector<float> &coefficients, size_t factor)
+        : length(factor ? (coefficients.size() + factor - 1) / factor : 0), factor(factor)
+    {
+        if (coefficients.empty())
+            throw std::invalid_argument("FIR should have at least one tap");
+        if (factor == 0)
+            throw std::invalid_argument("interpolation factor should be positive");
+        phases.assign(factor * length, 0.0f);
+        for (size_t p = 0; p < factor; p++)
+            for (size_t k = 0; p + k * factor < coefficients.size(); k++)
+                phases[p * length + (length - 1 - k)] = coefficients[p + k * factor];
+        work.assign(length - 1 + block_size, 0.0f);
+        acc.resize(block_size);
+        mixed.resize(block_size * factor);
+    }
+
+    /** 处理 n 个输入采样，out 需要 n * factor 个元素 */
+    void process(const Float24 *in, Float24 *out, size_t n)
+    {
+        const Float24Kernels &kernels = float24Kernels();
+        size_t history = length - 1;
+        for (size_t done = 0; done < n; done += block_size)
+        {
+            size_t m = n - done < block_size ? n - done : block_size;
+            kernels.toFloats(in + done, work.data() + history, m);
+            for (size_t p = 0; p < factor; p++)
+            {
+                kernels.fir(work.data(), &phases[p * length], length, acc.data(), m);
+                for (size_t j = 0; j < m; j++)
+                    mixed[j * factor + p] = acc[j];
+            }
+            kernels.fromFloats(mixed.data(), out + done * factor, m * factor);
+            std::copy(work.begin() + m, work.begin() + m + history, work.begin());
+        }
+    }
+    void reset() { std::fill(work.begin(), work.end(), 0.0f); }
+};
+
+/** 双二阶节系数，a0 已归一化为 1：
+    y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2] */
+struct Float24BiquadCoefficients
+{
+    double b0, b1, b2, a1, a2;
+};
+
+/** 级联双二阶滤波器，转置直接 II 型 */
+class Float24BiquadCascade
+{
+private:
+    std::vector<Float24BiquadCoefficients> sections;
+    std::vector<double> state; // 每节 z1, z2
+    std::vector<float> io;
+    std::vector<double> work;
+
+public:
+    static const size_t block_size = 1024;
+
+    explicit Float24BiquadCascade(const std::vector<Float24BiquadCoefficients> &sections)
+        : sections(sections), state(2 * sections.size(), 0.0), io(block_size), work(block_size) {}
+
+    /** 处理 n 个采样，out 可以与 in 相同 */
+    void process(const Float24 *in, Float24 *out, size_t n)
+    {
+        const Float24Kernels &kernels = float24Kernels();
+        for (size_t done = 0; done < n; done += block_size)
+        {
+            size_t m = n - done < block_size ? n - done : block_size;
+            kernels.toFloats(in + done, io.data(), m);
+            for (size_t i = 0; i < m; i++)
+                work[i] = io[i];
+            for (size_t s = 0; s < sections.size(); s++)
+            { // 逐节处理整块，系数与状态留在寄存器中
+                const Float24BiquadCoefficients c = sections[s];
+                double z1 = state[2 * s];
+                double z2 = state[2 * s + 1];
+                for (size_t i = 0; i < m; i++)
+                {
+                    double x = work[i];
+                    double y = c.b0 * x + z1;
+                    z1 = c.b1 * x - c.a1 * y + z2;
+                    z2 = c.b2 * x - c.a2 * y;
+                    work[i] = y;
+                }
+                state[2 * s] = z1;
+                state[2 * s + 1] = z2;
+            }
+            for (size_t i = 0; i < m; i++)
+                io[i] = static_cast<float>(work[i]);
+            kernels.fromFloats(io.data(), out + done, m);
+        }
+    }
+    void reset() { std::fill(state.begin(), state.end(), 0.0); }
+};
+
+#endif
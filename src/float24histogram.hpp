@@ -0,0 +1,186 @@
+#ifndef FLOAT24HISTOGRAM_HPP
+#define FLOAT24HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "float24batch.hpp"
+
+/** 精确直方图与分位数
+    Float24 只有 2^24 种位模式，直接以保序键（Float24::toOrderKey）为下标计数，没有分桶误差
+    另维护一层粗粒度计数（每 4096 个键一块），分位数查询先在粗层定位再在块内扫描
+    NaN 单独计数，不参与分位数与 rank；-0 与 +0 分别计数但相邻
+
+    内存：计数数组 128 MiB；addParallel 每个线程另需 64 MiB 的 32 位子直方图，
+    默认线程数不超过 max_default_threads，即最多另需 512 MiB */
+class Float24Histogram
+{
+public:
+    static const uint32_t key_count = 1U << 24;
+    static const unsigned coarse_shift = 12;
+    static const uint32_t coarse_count = key_count >> coarse_shift;
+    static const unsigned max_default_threads = 8;
+
+private:
+    std::vector<uint64_t> counts;
+    std::vector<uint64_t> coarse;
+    uint64_t total = 0; // 含 NaN
+
+    // 非 NaN 的键位于 [-Infinity, +Infinity]
+    static uint32_t inline lowestKey() { return Float24::bitsToOrderKey(0xFF0000); }
+    static uint32_t inline highestKey() { return Float24::bitsToOrderKey(0x7F0000); }
+
+    /** @return 键小于 key 的计数之和 */
+    uint64_t countBelow(uint32_t key) const
+    {
+        uint64_t sum = 0;
+        uint32_t block = key >> coarse_shift;
+        for (uint32_t b = 0; b < block; b++)
+            sum += coarse[b];
+        for (uint32_t k = block << coarse_shift; k < key; k++)
+            sum += counts[k];
+        return sum;
+    }
+    /** @return 累计计数首次达到 target（>= 1）的键 */
+    uint32_t findKey(uint64_t target) const
+    {
+        uint32_t block = 0;
+        for (; block < coarse_count && coarse[block] < target; block++)
+            target -= coarse[block];
+        uint32_t key = block << coarse_shift;
+        for (; counts[key] < target; key++)
+            target -= counts[key];
+        return key;
+    }
+
+public:
+    Float24Histogram() : counts(key_count, 0), coarse(coarse_count, 0) {}
+
+    void inline add(Float24 value)
+    {
+        uint32_t key = value.toOrderKey();
+        counts[key]++;
+        coarse[key >> coarse_shift]++;
+        total++;
+    }
+    void add(const Float24 *data, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            uint32_t key = Float24::bitsToOrderKey(float24Load(data + i));
+            counts[key]++;
+            coarse[key >> coarse_shift]++;
+        }
+        total += n;
+    }
+
+    /** 多线程计数：每个线程统计一段数据到自己的 32 位子直方图，最后按键区间并行合并
+        threads 为 0 时使用硬件线程数，但不超过 max_default_threads；计数受内存带宽限制，更多线程收益很小 */
+    void addParallel(const Float24 *data, size_t n, unsigned threads = 0)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+            threads = threads < max_default_threads ? threads : max_default_threads;
+        }
+        if (threads == 0)
+            threads = 1;
+        if (threads == 1 || n < key_count)
+            return add(data, n);
+
+        size_t slice = (n + threads - 1) / threads;
+        if (slice > 0xFFFFFFFFULL)
+            throw std::length_error("too many values per thread for 32-bit sub-histograms");
+        std::vector<std::vector<uint32_t>> locals(threads);
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; t++)
+            pool.emplace_back([&, t]()
+                              {
+                std::vector<uint32_t> &local = locals[t];
+                local.assign(key_count, 0);
+                size_t begin = t * slice < n ? t * slice : n;
+                size_t end = begin + slice < n ? begin + slice : n;
+                for (size_t i = begin; i < end; i++)
+                    local[Float24::bitsToOrderKey(float24Load(data + i))]++; });
+        for (std::thread &t : pool)
+            t.join();
+
+        pool.clear();
+        uint32_t range = coarse_count / threads + 1;
+        for (unsigned t = 0; t < threads; t++)
+            pool.emplace_back([&, t]()
+                              {
+                uint32_t first = t * range < coarse_count ? t * range : coarse_count;
+                uint32_t last = first + range < coarse_count ? first + range : coarse_count;
+                for (uint32_t b = first; b < last; b++)
+                {
+                    uint64_t sum = 0;
+                    for (uint32_t k = b << coarse_shift; k < (b + 1) << coarse_shift; k++)
+                    {
+                        uint64_t c = 0;
+                        for (const std::vector<uint32_t> &local : locals)
+                            c += local[k];
+                        counts[k] += c;
+                        sum += c;
+                    }
+                    coarse[b] += sum;
+                } });
+        for (std::thread &t : pool)
+            t.join();
+        total += n;
+    }
+
+    void merge(const Float24Histogram &other)
+    {
+        for (uint32_t k = 0; k < key_count; k++)
+            counts[k] += other.counts[k];
+        for (uint32_t b = 0; b < coarse_count; b++)
+            coarse[b] += other.coarse[b];
+        total += other.total;
+    }
+    void clear()
+    {
+        std::fill(counts.begin(), counts.end(), 0);
+        std::fill(coarse.begin(), coarse.end(), 0);
+        total = 0;
+    }
+
+    /** @return 非 NaN 值的个数 */
+    uint64_t inline count() const { return total - nanCount(); }
+    uint64_t inline nanCount() const
+    {
+        return countBelow(lowestKey()) + (total - countBelow(highestKey() + 1));
+    }
+    /** @return 与 value 位模式相同的值的个数 */
+    uint64_t inline count(Float24 value) const { return counts[value.toOrderKey()]; }
+
+    /** @return 不大于 value 的非 NaN 值的个数，-0 与 +0 相等 */
+    uint64_t rank(Float24 value) const
+    {
+        if (value.isNaN())
+            throw std::invalid_argument("rank of NaN");
+        uint32_t key = value.isZero() ? Float24().toOrderKey() : value.toOrderKey(); // +0 的键在 -0 之后
+        return countBelow(key + 1) - countBelow(lowestKey());
+    }
+
+    /** 最近秩分位数：最小的 x，使不大于 x 的值至少有 ceil(q * count()) 个
+        @param q 取值 [0, 1] */
+    Float24 quantile(double q) const
+    {
+        if (!(q >= 0.0 && q <= 1.0))
+            throw std::invalid_argument("quantile should be in [0, 1]");
+        uint64_t valid = count();
+        if (valid == 0)
+            throw std::logic_error("quantile of empty histogram");
+        uint64_t r = static_cast<uint64_t>(std::ceil(q * static_cast<double>(valid)));
+        r = r < 1 ? 1 : (r > valid ? valid : r);
+        return Float24::fromOrderKey(findKey(countBelow(lowestKey()) + r));
+    }
+    Float24 inline median() const { return quantile(0.5); }
+    Float24 inline min() const { return quantile(0.0); }
+    Float24 inline max() const { return quantile(1.0); }
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef FLOAT24PCM_HPP
+#define FLOAT24PCM_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "float24batch.hpp"
+
+/** PCM 整数采样与 Float24 的批量转换
+    输入：采样值 * scale 后转换为 Float24（向零截断），默认 scale 把满量程映射到 [-1, 1)
+    输出：Float24 * scale 后四舍五入（远离零），超出位宽时饱和，NaN 输出 0
+    16/24 位 PCM 为小端有符号整数，24 位为紧凑的 3 字节 */
+
+const float float24Pcm16Scale = 32768.0f;
+const float float24Pcm24Scale = 8388608.0f;
+const float float24Int32Scale = 2147483648.0f;
+
+/** 饱和并四舍五入到 [lo, hi]，lo/hi 需可被 f32 精确表示
+    全部写成无分支形式（NaN 用位掩码清零，copysign 取舍入方向，min/max 饱和），使循环可被向量化 */
+inline int32_t float24PcmRound(float x, float lo, float hi)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits &= 0U - ((bits & 0x7FFFFFFF) <= 0x7F800000); // NaN -> +0
+    std::memcpy(&x, &bits, sizeof(x));
+    x += std::copysign(0.5f, x); // 先舍入再饱和：lo/hi 为整数，截断结果相同
+    return static_cast<int32_t>(std::min(std::max(x, lo), hi));
+}
+
+inline void float24FromPcm16(const int16_t *in, Float24 *out, size_t n, float scale = 1.0f / float24Pcm16Scale)
+{
+    for (size_t i = 0; i < n; i++)
+        float24Store(out + i, float24BitsFromFloat(static_cast<float>(in[i]) * scale));
+}
+inline void float24ToPcm16(const Float24 *in, int16_t *out, size_t n, float scale = float24Pcm16Scale)
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = static_cast<int16_t>(float24PcmRound(float24BitsToFloat(float24Load(in + i)) * scale, -32768.0f, 32767.0f));
+}
+
+inline void float24FromPcm24(const uint8_t *in, Float24 *out, size_t n, float scale = 1.0f / float24Pcm24Scale)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const uint8_t *p = in + 3 * i;
+        uint32_t u = static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16;
+        int32_t sample = static_cast<int32_t>(u << 8) >> 8; // 符号扩展
+        float24Store(out + i, float24BitsFromFloat(static_cast<float>(sample) * scale));
+    }
+}
+inline void float24ToPcm24(const Float24 *in, uint8_t *out, size_t n, float scale = float24Pcm24Scale)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t sample = static_cast<uint32_t>(float24PcmRound(float24BitsToFloat(float24Load(in + i)) * scale, -8388608.0f, 8388607.0f));
+        uint8_t *p = out + 3 * i;
+        p[0] = static_cast<uint8_t>(sample);
+        p[1] = static_cast<uint8_t>(sample >> 8);
+        p[2] = static_cast<uint8_t>(sample >> 16);
+    }
+}
+
+inline void float24FromInt32(const int32_t *in, Float24 *out, size_t n, float scale = 1.0f / float24Int32Scale)
+{
+    for (size_t i = 0; i < n; i++)
+        float24Store(out + i, float24BitsFromFloat(static_cast<float>(in[i]) * scale));
+}
+inline void float24ToInt32(const Float24 *in, int32_t *out, size_t n, float scale = float24Int32Scale)
+{
+    for (size_t i = 0; i < n; i++) // 2147483520 为小于 2^31 的最大 f32
+        out[i] = float24PcmRound(float24BitsToFloat(float24Load(in + i)) * scale, -2147483648.0f, 2147483520.0f);
+}
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef FLOAT24SOFT_HPP
+#define FLOAT24SOFT_HPP
+
+#include <cstdint>
+#include <utility>
+
+/** 纯整数软浮点，在 24 位位模式上运算（布局同 Float24::toBits）
+    结果与经 f32 计算后再向零截断逐位一致：先把精确结果就近偶数舍入到 24 位有效位（同 f32），
+    再截断为 16 位尾数；上溢为 Infinity，低于最小规格化数时为带符号的 0
+    唯一的区别是 NaN 的位模式：这里总是返回 Float24::qNaN() */
+
+const uint32_t float24SoftNaN = 0x7F8000;
+const uint32_t float24SoftInfinity = 0x7F0000;
+
+inline int float24SoftMsb(uint64_t m)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(m);
+#else
+    int msb = 0;
+    while (m >>= 1)
+        msb++;
+    return msb;
+#endif
+}
+
+/** 拆分为 符号、有效位 m 与比例 scale，值为 m * 2^scale，m 含隐含的前导 1 */
+inline void float24SoftUnpack(uint32_t bits, uint32_t &sign, uint64_t &m, int &scale)
+{
+    uint32_t exponent = (bits >> 16) & 0x7F;
+    sign = (bits >> 23) & 1;
+    m = exponent ? (bits & 0xFFFF) | 0x10000 : bits & 0xFFFF;
+    scale = (exponent ? static_cast<int>(exponent) : 1) - 63 - 16;
+}
+
+inline bool float24SoftIsNaN(uint32_t bits) { return (bits & 0x7F0000) == 0x7F0000 && (bits & 0xFFFF); }
+inline bool float24SoftIsInfinity(uint32_t bits) { return (bits & 0x7FFFFF) == 0x7F0000; }
+
+/** 打包 (-1)^sign * (m + ε) * 2^scale，m 非零，sticky 表示 0 < ε < 1
+    sticky 为真时 m 至少有 26 位有效位，使 ε 总在舍入位之下 */
+inline uint32_t float24SoftPack(uint32_t sign, uint64_t m, int scale, bool sticky)
+{
+    int msb = float24SoftMsb(m);
+    if (msb > 23)
+    { // 就近偶数舍入到 24 位
+        int shift = msb - 23;
+        uint64_t lost = m & ((1ULL << shift) - 1);
+        uint64_t half = 1ULL << (shift - 1);
+        m >>= shift;
+        scale += shift;
+        if (lost > half || (lost == half && (sticky || (m & 1))))
+            m++;
+        if (m >> 24)
+        {
+            m >>= 1;
+            scale++;
+        }
+    }
+    else
+    {
+        m <<= 23 - msb;
+        scale -= 23 - msb;
+    }
+
+    int exponent = scale + 23 + 63;
+    sign <<= 23;
+    if (exponent >= 127)
+        return sign | float24SoftInfinity;
+    if (exponent <= 0)
+        return sign;
+    return sign | static_cast<uint32_t>(exponent) << 16 | static_cast<uint32_t>(m >> 7 & 0xFFFF);
+}
+
+inline uint32_t float24SoftAdd(uint32_t a, uint32_t b)
+{
+    if (float24SoftIsNaN(a) || float24SoftIsNaN(b))
+        return float24SoftNaN;
+    if (float24SoftIsInfinity(a))
+        return float24SoftIsInfinity(b) && (a ^ b) ? float24SoftNaN : a; // 正无穷 + 负无穷 = NaN
+    if (float24SoftIsInfinity(b))
+        return b;
+
+    uint32_t sa, sb;
+    uint64_t ma, mb;
+    int xa, xb;
+    float24SoftUnpack(a, sa, ma, xa);
+    float24SoftUnpack(b, sb, mb, xb);
+    if (ma == 0 && mb == 0)
+        return (sa & sb) << 23;
+    if (ma == 0)
+        return float24SoftPack(sb, mb, xb, false);
+    if (mb == 0)
+        return float24SoftPack(sa, ma, xa, false);
+
+    if (xa < xb)
+    {
+        std::swap(sa, sb);
+        std::swap(ma, mb);
+        std::swap(xa, xb);
+    }
+    // 左移 40 位留出保护位，对阶时移出的位记入 sticky
+    ma <<= 40;
+    mb <<= 40;
+    int shift = xa - xb;
+    xa -= 40;
+    bool sticky = false;
+    if (shift >= 64)
+    {
+        sticky = true;
+        mb = 0;
+    }
+    else if (shift > 0)
+    {
+        sticky = (mb & ((1ULL << shift) - 1)) != 0;
+        mb >>= shift;
+    }
+
+    if (sa == sb)
+        return float24SoftPack(sa, ma + mb, xa, sticky);
+    // 只有 shift > 40 时 sticky 才为真，此时 ma >= 2^40 > mb
+    if (ma > mb)
+        return sticky ? float24SoftPack(sa, ma - mb - 1, xa, true) : float24SoftPack(sa, ma - mb, xa, false);
+    if (mb > ma)
+        return float24SoftPack(sb, mb - ma, xa, sticky);
+    return 0; // 抵消为 +0
+}
+
+inline uint32_t float24SoftSub(uint32_t a, uint32_t b) { return float24SoftAdd(a, b ^ 0x800000); }
+
+inline uint32_t float24SoftMul(uint32_t a, uint32_t b)
+{
+    if (float24SoftIsNaN(a) || float24SoftIsNaN(b))
+        return float24SoftNaN;
+    uint32_t sign = ((a ^ b) >> 23) & 1;
+    bool zero_a = (a & 0x7FFFFF) == 0, zero_b = (b & 0x7FFFFF) == 0;
+    if (float24SoftIsInfinity(a) || float24SoftIsInfinity(b))
+        return zero_a || zero_b ? float24SoftNaN : sign << 23 | float24SoftInfinity; // Infinity * 0 = NaN
+    if (zero_a || zero_b)
+        return sign << 23;
+
+    uint32_t sa, sb;
+    uint64_t ma, mb;
+    int xa, xb;
+    float24SoftUnpack(a, sa, ma, xa);
+    float24SoftUnpack(b, sb, mb, xb);
+    return float24SoftPack(sign, ma * mb, xa + xb, false); // 34 位乘积是精确的
+}
+
+inline uint32_t float24SoftDiv(uint32_t a, uint32_t b)
+{
+    if (float24SoftIsNaN(a) || float24SoftIsNaN(b))
+        return float24SoftNaN;
+    uint32_t sign = ((a ^ b) >> 23) & 1;
+    bool zero_a = (a & 0x7FFFFF) == 0, zero_b = (b & 0x7FFFFF) == 0;
+    if (float24SoftIsInfinity(a))
+        return float24SoftIsInfinity(b) ? float24SoftNaN : sign << 23 | float24SoftInfinity;
+    if (float24SoftIsInfinity(b))
+        return sign << 23;
+    if (zero_b)
+        return zero_a ? float24SoftNaN : sign << 23 | float24SoftInfinity; // 0 / 0 = NaN
+    if (zero_a)
+        return sign << 23;
+
+    uint32_t sa, sb;
+    uint64_t ma, mb;
+    int xa, xb;
+    float24SoftUnpack(a, sa, ma, xa);
+    float24SoftUnpack(b, sb, mb, xb);
+    // 非规格化数先规格化，使商在 (2^39, 2^41) 内
+    int na = 16 - float24SoftMsb(ma), nb = 16 - float24SoftMsb(mb);
+    ma <<= na;
+    mb <<= nb;
+    uint64_t n = ma << 40;
+    return float24SoftPack(sign, n / mb, xa - na - 40 - (xb - nb), n % mb != 0);
+}
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef FLOAT24WAV_HPP
+#define FLOAT24WAV_HPP
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "float24dispatch.hpp"
+
+/** 流式读写 PCM WAV 文件，采样在内存中为交错排列的 Float24，满量程对应 [-1, 1)
+    支持 16/24/32 位整数 PCM（含 WAVE_FORMAT_EXTENSIBLE），按块调用分派后的批量转换内核 */
+class Float24Wav
+{
+public:
+    static const size_t block_samples = 4096; // 每次转换的采样数
+
+    static uint16_t inline readU16(const uint8_t *p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+    static uint32_t inline readU32(const uint8_t *p)
+    {
+        return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+    }
+    static void inline writeU16(uint8_t *p, uint16_t v)
+    {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+    static void inline writeU32(uint8_t *p, uint32_t v)
+    {
+        for (int i = 0; i < 4; i++)
+            p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    static const bool little_endian = true;
+#else
+    static const bool little_endian = false;
+#endif
+
+    /** 准备 samples 个采样的缓冲区，返回文件读写直接使用的字节区：
+        小端主机上 16/32 位采样直接读写到 pcm16/pcm32，省去逐字节转换，其余情况使用 bytes */
+    static char inline *ioBuffer(uint16_t bits, size_t samples, std::vector<uint8_t> &bytes,
+                                 std::vector<int16_t> &pcm16, std::vector<int32_t> &pcm32)
+    {
+        if (bits == 16)
+        {
+            pcm16.resize(samples);
+            if (little_endian)
+                return reinterpret_cast<char *>(pcm16.data());
+        }
+        else if (bits == 32)
+        {
+            pcm32.resize(samples);
+            if (little_endian)
+                return reinterpret_cast<char *>(pcm32.data());
+        }
+        bytes.resize(samples * (bits / 8));
+        return reinterpret_cast<char *>(bytes.data());
+    }
+
+    static void inline checkBits(uint16_t bits)
+    {
+        if (bits != 16 && bits != 24 && bits != 32)
+            throw std::invalid_argument("WAV bits per sample should be 16, 24 or 32");
+    }
+};
+
+class Float24WavReader
+{
+private:
+    std::ifstream file;
+    uint16_t channels = 0;
+    uint32_t sample_rate = 0;
+    uint16_t bits = 0;
+    uint64_t frames = 0;
+    uint64_t remaining = 0; // 未读帧数
+    std::vector<uint8_t> buffer; // 24 位采样，及大端主机上的原始字节
+    std::vector<int16_t> pcm16;
+    std::vector<int32_t> pcm32;
+
+public:
+    explicit Float24WavReader(const std::string &path) : file(path, std::ios::binary)
+    {
+        if (!file)
+            throw std::runtime_error("cannot open '" + path + "'");
+        uint8_t riff[12];
+        if (!file.read(reinterpret_cast<char *>(riff), sizeof(riff)) ||
+            std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0)
+            throw std::runtime_error("'" + path + "' is not a WAV file");
+
+        bool has_format = false;
+        uint8_t header[8];
+        while (file.read(reinterpret_cast<char *>(header), sizeof(header)))
+        {
+            uint32_t size = Float24Wav::readU32(header + 4);
+            if (std::memcmp(header, "fmt ", 4) == 0)
+            {
+                std::vector<uint8_t> fmt(size < 16 ? 16 : size);
+                if (!file.read(reinterpret_cast<char *>(fmt.data()), size))
+                    break;
+                uint16_t format = Float24Wav::readU16(&fmt[0]);
+                if (format == 0xFFFE && size >= 26) // WAVE_FORMAT_EXTENSIBLE，子格式 GUID 的前 2 字节
+                    format = Float24Wav::readU16(&fmt[24]);
+                if (format != 1)
+                    throw std::runtime_error("only integer PCM WAV is supported");
+                channels = Float24Wav::readU16(&fmt[2]);
+                sample_rate = Float24Wav::readU32(&fmt[4]);
+                bits = Float24Wav::readU16(&fmt[14]);
+                Float24Wav::checkBits(bits);
+                if (channels == 0)
+                    throw std::runtime_error("WAV has no channels");
+                has_format = true;
+                if (size & 1)
+                    file.ignore(1);
+            }
+            else if (std::memcmp(header, "data", 4) == 0)
+            {
+                if (!has_format)
+                    throw std::runtime_error("WAV data chunk before fmt chunk");
+                frames = size / (channels * (bits / 8));
+                remaining = frames;
+                return;
+            }
+            else
+                file.ignore(size + (size & 1));
+        }
+        throw std::runtime_error("'" + path + "' has no WAV data");
+    }
+
+    uint16_t inline getChannels() const { return channels; }
+    uint32_t inline getSampleRate() const { return sample_rate; }
+    uint16_t inline getBitsPerSample() const { return bits; }
+    uint64_t inline getFrames() const { return frames; }
+
+    /** 读取至多 count 帧到 out（交错，count * channels 个采样）
+        data 块被截断或声明的大小超出文件时，返回已完整读到的帧数，之后视为结束
+        @return 实际读取的帧数，0 表示结束 */
+    size_t read(Float24 *out, size_t count)
+    {
+        const Float24Kernels &kernels = float24Kernels();
+        size_t bytes_per_sample = bits / 8;
+        size_t done = 0;
+        count = count < remaining ? count : static_cast<size_t>(remaining);
+        while (done < count)
+        {
+            size_t block_frames = Float24Wav::block_samples / channels;
+            block_frames = block_frames ? block_frames : 1;
+            block_frames = count - done < block_frames ? count - done : block_frames;
+            size_t samples = block_frames * channels;
+            char *raw = Float24Wav::ioBuffer(bits, samples, buffer, pcm16, pcm32);
+            file.read(raw, samples * bytes_per_sample);
+            size_t got = static_cast<size_t>(file.gcount()) / (bytes_per_sample * channels); // 完整的帧
+            samples = got * channels;
+
+            Float24 *dst = out + done * channels;
+            if (bits == 16)
+            {
+                if (!Float24Wav::little_endian)
+                    for (size_t i = 0; i < samples; i++)
+                        pcm16[i] = static_cast<int16_t>(Float24Wav::readU16(&buffer[2 * i]));
+                kernels.fromPcm16(pcm16.data(), dst, samples, 1.0f / float24Pcm16Scale);
+            }
+            else if (bits == 24)
+                kernels.fromPcm24(buffer.data(), dst, samples, 1.0f / float24Pcm24Scale);
+            else
+            {
+                if (!Float24Wav::little_endian)
+                    for (size_t i = 0; i < samples; i++)
+                        pcm32[i] = static_cast<int32_t>(Float24Wav::readU32(&buffer[4 * i]));
+                kernels.fromInt32(pcm32.data(), dst, samples, 1.0f / float24Int32Scale);
+            }
+            done += got;
+            if (got < block_frames)
+            { // data 块被截断，之后视为结束
+                remaining = 0;
+                return done;
+            }
+        }
+        remaining -= done;
+        return done;
+    }
+};
+
+class Float24WavWriter
+{
+private:
+    std::ofstream file;
+    uint16_t channels;
+    uint32_t sample_rate;
+    uint16_t bits;
+    uint64_t data_bytes = 0;
+    std::vector<uint8_t> buffer;
+    std::vector<int16_t> pcm16;
+    std::vector<int32_t> pcm32;
+
+    void writeHeader()
+    {
+        uint8_t header[44];
+        uint16_t block_align = static_cast<uint16_t>(channels * (bits / 8));
+        std::memcpy(header, "RIFF", 4);
+        Float24Wav::writeU32(header + 4, static_cast<uint32_t>(36 + data_bytes + (data_bytes & 1)));
+        std::memcpy(header + 8, "WAVEfmt ", 8);
+        Float24Wav::writeU32(header + 16, 16);
+        Float24Wav::writeU16(header + 20, 1); // PCM
+        Float24Wav::writeU16(header + 22, channels);
+        Float24Wav::writeU32(header + 24, sample_rate);
+        Float24Wav::writeU32(header + 28, sample_rate * block_align);
+        Float24Wav::writeU16(header + 32, block_align);
+        Float24Wav::writeU16(header + 34, bits);
+        std::memcpy(header + 36, "data", 4);
+        Float24Wav::writeU32(header + 40, static_cast<uint32_t>(data_bytes));
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+
+public:
+    Float24WavWriter(const std::string &path, uint16_t channels, uint32_t sample_rate, uint16_t bits = 24)
+        : file(path, std::ios::binary | std::ios::trunc), channels(channels), sample_rate(sample_rate), bits(bits)
+    {
+        Float24Wav::checkBits(bits);
+        if (channels == 0)
+            throw std::invalid_argument("WAV should have at least one channel");
+        if (!file)
+            throw std::runtime_error("cannot open '" + path + "'");
+        writeHeader(); // 大小在 close 时回填
+    }
+    ~Float24WavWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+    Float24WavWriter(const Float24WavWriter &) = delete;
+    Float24WavWriter &operator=(const Float24WavWriter &) = delete;
+
+    /** 写入 count 帧（交错，count * channels 个采样），超出满量程的值饱和 */
+    void write(const Float24 *in, size_t count)
+    {
+        if (!file.is_open())
+            throw std::logic_error("WAV writer already closed");
+        const Float24Kernels &kernels = float24Kernels();
+        size_t bytes_per_sample = bits / 8;
+        size_t total = count * channels;
+        for (size_t done = 0; done < total; done += Float24Wav::block_samples)
+        {
+            size_t samples = total - done < Float24Wav::block_samples ? total - done : Float24Wav::block_samples;
+            const char *raw = Float24Wav::ioBuffer(bits, samples, buffer, pcm16, pcm32);
+            if (bits == 16)
+            {
+                kernels.toPcm16(in + done, pcm16.data(), samples, float24Pcm16Scale);
+                if (!Float24Wav::little_endian)
+                    for (size_t i = 0; i < samples; i++)
+                        Float24Wav::writeU16(&buffer[2 * i], static_cast<uint16_t>(pcm16[i]));
+            }
+            else if (bits == 24)
+                kernels.toPcm24(in + done, buffer.data(), samples, float24Pcm24Scale);
+            else
+            {
+                kernels.toInt32(in + done, pcm32.data(), samples, float24Int32Scale);
+                if (!Float24Wav::little_endian)
+                    for (size_t i = 0; i < samples; i++)
+                        Float24Wav::writeU32(&buffer[4 * i], static_cast<uint32_t>(pcm32[i]));
+            }
+            file.write(raw, samples * bytes_per_sample);
+        }
+        data_bytes += total * bytes_per_sample;
+        if (data_bytes > 0xFFFFFFFFULL - 36)
+            throw std::runtime_error("WAV data exceeds 4 GiB");
+        if (!file)
+            throw std::runtime_error("failed to write WAV data");
+    }
+
+    /** 回填 RIFF 与 data 块大小并关闭文件 */
+    void close()
+    {
+        if (!file.is_open())
+            return;
+        if (data_bytes & 1)
+            file.put(0); // 块按偶数字节对齐
+        file.seekp(0);
+        writeHeader();
+        file.close();
+        if (!file)
+            throw std::runtime_error("failed to finalize WAV file");
+    }
+};
+
+#endif
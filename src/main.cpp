@@ -1,7 +1,13 @@
+#include <atomic>
 #include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <cctype>
 #include <cstring>
 #include <stdexcept>
@@ -40,10 +46,75 @@ Float24 applyOp(Float24 a, Float24 b, char op)
     }
 }
 
-// 解析并计算表达式
-Float24 evaluate(const std::string &tokens)
+// 编译后的表达式：后缀形式的指令序列
+struct CompiledExpression
+{
+    struct Step
+    {
+        char op;     // 0 表示压入常量
+        float value; // 常量按 float 保存，运行时再转换，以遵循当前的舍入方式
+    };
+    std::vector<Step> program;
+    bool has_result = false; // 向零截断下的结果已在编译时算出
+    Float24 result;
+};
+
+// 执行指令序列，结果留在 values 中；常量转换与运算的顺序与逐字符求值时相同
+void execute(const std::vector<CompiledExpression::Step> &program, std::vector<Float24> &values)
+{
+    for (const CompiledExpression::Step &step : program)
+    {
+        if (step.op == 0)
+        {
+            values.push_back(Float24(step.value));
+            continue;
+        }
+        Float24 val2 = values.back();
+        values.pop_back();
+        Float24 val1 = values.back();
+        values.pop_back();
+        values.push_back(applyOp(val1, val2, step.op));
+    }
+}
+
+Float24 run(const std::vector<CompiledExpression::Step> &program)
+{
+    std::vector<Float24> values;
+    values.reserve(program.size());
+    execute(program, values);
+    return values.back();
+}
+
+// 语法错误：逐字符求值时，出错位置之前的运算已经执行，其中的运行时错误（如除零）先被报告，
+// 因此先执行已编译的部分，再抛出语法错误
+[[noreturn]] void syntaxError(const std::vector<CompiledExpression::Step> &program, const std::string &message)
+{
+    std::vector<Float24> values;
+    execute(program, values);
+    throw std::invalid_argument(message);
+}
+
+// 输出一个运算符，depth 为运行时值栈的深度
+void emitOp(std::vector<CompiledExpression::Step> &program, size_t &depth, char op, const char *error)
 {
-    std::stack<Float24> values;
+    if (depth < 2)
+    {
+        syntaxError(program, error);
+    }
+    if (op == '(')
+    {
+        syntaxError(program, "Invalid operator");
+    }
+    depth--;
+    program.push_back({op, 0.0f});
+}
+
+// 调度场算法编译表达式，语法错误在此抛出
+std::shared_ptr<const CompiledExpression> compile(const std::string &tokens)
+{
+    std::shared_ptr<CompiledExpression> compiled = std::make_shared<CompiledExpression>();
+    std::vector<CompiledExpression::Step> &program = compiled->program;
+    size_t depth = 0;
     std::stack<char> ops;
     std::istringstream iss(tokens);
     char token;
@@ -55,7 +126,8 @@ Float24 evaluate(const std::string &tokens)
             iss.putback(token);
             float value;
             iss >> value;
-            values.push(Float24(value));
+            program.push_back({0, value});
+            depth++;
         }
         else if (token == '(')
         {
@@ -65,21 +137,12 @@ Float24 evaluate(const std::string &tokens)
         {
             while (!ops.empty() && ops.top() != '(')
             {
-                if (values.size() < 2)
-                {
-                    throw std::invalid_argument("Mismatched parentheses or missing operand");
-                }
-                Float24 val2 = values.top();
-                values.pop();
-                Float24 val1 = values.top();
-                values.pop();
-                char op = ops.top();
+                emitOp(program, depth, ops.top(), "Mismatched parentheses or missing operand");
                 ops.pop();
-                values.push(applyOp(val1, val2, op));
             }
             if (ops.empty())
             {
-                throw std::invalid_argument("Mismatched parentheses");
+                syntaxError(program, "Mismatched parentheses");
             }
             ops.pop();
         }
@@ -87,17 +150,8 @@ Float24 evaluate(const std::string &tokens)
         {
             while (!ops.empty() && precedence(ops.top()) >= precedence(token))
             {
-                if (values.size() < 2)
-                {
-                    throw std::invalid_argument("Missing operand for operator");
-                }
-                Float24 val2 = values.top();
-                values.pop();
-                Float24 val1 = values.top();
-                values.pop();
-                char op = ops.top();
+                emitOp(program, depth, ops.top(), "Missing operand for operator");
                 ops.pop();
-                values.push(applyOp(val1, val2, op));
             }
             ops.push(token);
         }
@@ -106,31 +160,120 @@ Float24 evaluate(const std::string &tokens)
             std::string error = "Invalid character '";
             error += token;
             error += "' in expression";
-            throw std::invalid_argument(error);
+            syntaxError(program, error);
         }
     }
 
     while (!ops.empty())
     {
-        if (values.size() < 2)
+        emitOp(program, depth, ops.top(), "Missing operand for operator");
+        ops.pop();
+    }
+
+    if (depth != 1)
+    {
+        syntaxError(program, "Invalid expression");
+    }
+
+    // 表达式只含常量，向零截断下结果是确定的，可直接缓存；除零等运行时错误留到每次求值时抛出
+    if (Float24::rounding() == Float24Rounding::TowardZero)
+    {
+        try
         {
-            throw std::invalid_argument("Missing operand for operator");
+            compiled->result = run(program);
+            compiled->has_result = true;
         }
-        Float24 val2 = values.top();
-        values.pop();
-        Float24 val1 = values.top();
-        values.pop();
-        char op = ops.top();
-        ops.pop();
-        values.push(applyOp(val1, val2, op));
+        catch (const std::invalid_argument &)
+        {
+        }
+    }
+    return compiled;
+}
+
+// 表达式缓存：以表达式文本为键，容量有限，按最近最少使用淘汰，可多线程共享
+class ExpressionCache
+{
+private:
+    typedef std::list<std::pair<std::string, std::shared_ptr<const CompiledExpression>>> Entries;
+
+    size_t capacity;
+    Entries entries; // 最近使用的在前
+    std::unordered_map<std::string, Entries::iterator> index;
+    mutable std::mutex mutex;
+    std::atomic<uint64_t> hit_count{0};
+    std::atomic<uint64_t> miss_count{0};
+
+public:
+    explicit ExpressionCache(size_t capacity = 1024) : capacity(capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("Cache capacity should be positive");
+        }
+    }
+
+    // 查找或编译表达式，编译失败时抛出异常且不缓存
+    std::shared_ptr<const CompiledExpression> get(const std::string &tokens)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = index.find(tokens);
+            if (it != index.end())
+            {
+                entries.splice(entries.begin(), entries, it->second);
+                hit_count++;
+                return it->second->second;
+            }
+        }
+        miss_count++;
+        std::shared_ptr<const CompiledExpression> compiled = compile(tokens); // 在锁外编译
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(tokens);
+        if (it != index.end()) // 其他线程已插入
+        {
+            return it->second->second;
+        }
+        entries.emplace_front(tokens, compiled);
+        index[tokens] = entries.begin();
+        if (entries.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        return compiled;
     }
 
-    if (values.size() != 1)
+    uint64_t hits() const { return hit_count; }
+    uint64_t misses() const { return miss_count; }
+    size_t size() const
     {
-        throw std::invalid_argument("Invalid expression");
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
     }
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        index.clear();
+    }
+};
 
-    return values.top();
+ExpressionCache &expressionCache()
+{
+    static ExpressionCache cache;
+    return cache;
+}
+
+// 解析并计算表达式，重复的表达式从缓存中取编译结果
+Float24 evaluate(const std::string &tokens)
+{
+    std::shared_ptr<const CompiledExpression> compiled = expressionCache().get(tokens);
+    if (compiled->has_result && Float24::rounding() == Float24Rounding::TowardZero)
+    {
+        return compiled->result;
+    }
+    return run(compiled->program);
 }
 
 // REPL 主函数
@@ -147,6 +290,14 @@ int main()
         if (line == "exit")
             break;
 
+        if (line == "stats")
+        {
+            ExpressionCache &cache = expressionCache();
+            std::cout << "Cache: " << cache.hits() << " hits, " << cache.misses() << " misses, "
+                      << cache.size() << " entries" << std::endl;
+            continue;
+        }
+
         try
         {
             Float24 result = evaluate(line);
@@ -0,0 +1,657 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "float24array.hpp"
+#include "float24atomic.hpp"
+#include "float24codec.hpp"
+#include "float24dispatch.hpp"
+#include "float24fft.hpp"
+#include "float24filter.hpp"
+#include "float24histogram.hpp"
+#include "float24soft.hpp"
+#include "float24wav.hpp"
+
+// 回归测试：make test 编译并运行，失败时返回非 0
+
+static int failures = 0;
+
+#define CHECK(cond)                                                              \
+    do                                                                           \
+    {                                                                            \
+        if (!(cond))                                                             \
+        {                                                                        \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #cond << std::endl; \
+            failures++;                                                          \
+        }                                                                        \
+    } while (0)
+
+// 随机舍入的均值等于原值（f32 中被截掉的 7 位之内无偏）
+static void testStochasticUnbiased()
+{
+    Float24RoundingScope scope(Float24Rounding::Stochastic);
+    const float values[] = {1.0f + 0.3f / 65536.0f, -3.0f - 0.7f / 32768.0f, 0.1f};
+    for (float v : values)
+    {
+        const int samples = 100000;
+        double sum = 0.0;
+        for (int i = 0; i < samples; i++)
+            sum += Float24(v).toFloat();
+        Float24 below = Float24::truncate(v);
+        double ulp = std::ldexp(1.0, below.getExponent() - 63 - 16);
+        CHECK(std::fabs(sum / samples - v) < 0.01 * ulp);
+    }
+}
+
+// 分段调用（offset 接续）与一次调用的随机舍入结果逐位一致
+static void testStochasticBatchSplit()
+{
+    const size_t n = 1000, split = 333;
+    Float24Rng rng(11);
+    std::vector<Float24> x(n), whole(n), parts(n), dispatched(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        x[i] = Float24::fromBits(rng.next() & 0x3FFFFF); // 有限正数，避免 NaN
+        whole[i] = parts[i] = dispatched[i] = Float24(static_cast<float>(i));
+    }
+    float24Accumulate(whole.data(), x.data(), n, rng, 100);
+    float24Accumulate(parts.data(), x.data(), split, rng, 100);
+    float24Accumulate(parts.data() + split, x.data() + split, n - split, rng, 100 + split);
+    float24Kernels().addStochastic(dispatched.data(), x.data(), dispatched.data(), n, rng, 100);
+    for (size_t i = 0; i < n; i++)
+    {
+        CHECK(whole[i].toBits() == parts[i].toBits());
+        Float24 expected = Float24::stochastic(static_cast<double>(i) + x[i].toFloat(), rng.at(100 + i));
+        CHECK(dispatched[i].toBits() == expected.toBits());
+    }
+}
+
+// NaN 与 Infinity 不受随机舍入影响；进位传递到阶码，最大有限值进位为 Infinity
+static void testStochasticSpecials()
+{
+    const float infinity = std::numeric_limits<float>::infinity();
+    for (uint32_t random : {0U, 1U, 0x7FU, 0xFFFFFFFFU})
+    {
+        CHECK(Float24::stochastic(infinity, random).toBits() == 0x7F0000);
+        CHECK(Float24::stochastic(-infinity, random).toBits() == 0xFF0000);
+        CHECK(Float24::stochastic(std::nanf(""), random).isNaN());
+        CHECK(Float24::stochastic(static_cast<double>(infinity), random).toBits() == 0x7F0000);
+        CHECK(Float24::stochastic(static_cast<double>(std::nanf("")), random).isNaN());
+        CHECK(float24BitsFromFloat(-infinity, random) == 0xFF0000);
+    }
+
+    const float below_two = std::nextafter(2.0f, 0.0f); // 尾数全 1
+    CHECK(Float24::stochastic(below_two, 0).toBits() == Float24::truncate(below_two).toBits());
+    CHECK(Float24::stochastic(below_two, 1).toBits() == Float24::truncate(2.0f).toBits());
+    CHECK(Float24::stochastic(-below_two, 1).toBits() == Float24::truncate(-2.0f).toBits());
+    CHECK(float24BitsFromFloat(below_two, 1) == Float24::truncate(2.0f).toBits());
+
+    uint32_t largest_bits = 0x5F7FFFFF; // 2^63 * (2 - 2^-23)，截断为最大有限 Float24
+    float largest;
+    std::memcpy(&largest, &largest_bits, sizeof(largest));
+    CHECK(Float24::stochastic(largest, 0).toBits() == 0x7EFFFF);
+    CHECK(Float24::stochastic(largest, 1).toBits() == 0x7F0000);
+}
+
+// 多线程 fetch_add 精确可表示的增量，和是精确的
+static void testAtomicFetchAdd()
+{
+    AtomicFloat24 sum;
+    const int threads = 4, iterations = 10000;
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back([&sum]()
+                          {
+            for (int i = 0; i < iterations; i++)
+                sum.fetch_add(Float24(0.25f)); });
+    for (std::thread &t : pool)
+        t.join();
+    CHECK(sum.load().toFloat() == 0.25f * threads * iterations);
+}
+
+// fetch_min/fetch_max：NaN 参数不写入，值不变时直接返回；CAS 失败时更新 expected
+static void testAtomicMinMaxCas()
+{
+    AtomicFloat24 a(Float24(5.0f));
+    const std::memory_order orders[] = {std::memory_order_relaxed, std::memory_order_release,
+                                        std::memory_order_acq_rel, std::memory_order_seq_cst};
+    for (std::memory_order order : orders)
+    {
+        CHECK(a.fetch_min(Float24::qNaN(), order).toFloat() == 5.0f);
+        CHECK(a.fetch_max(Float24::qNaN(), order).toFloat() == 5.0f);
+        CHECK(a.fetch_min(Float24(7.0f), order).toFloat() == 5.0f); // 不变
+        CHECK(a.fetch_max(Float24(5.0f), order).toFloat() == 5.0f); // 相等，不变
+        CHECK(a.load().toBits() == Float24(5.0f).toBits());
+    }
+    CHECK(a.fetch_min(Float24(-1.0f)).toFloat() == 5.0f);
+    CHECK(a.fetch_max(Float24(3.0f)).toFloat() == -1.0f);
+    CHECK(a.load().toFloat() == 3.0f);
+
+    Float24 expected(2.0f);
+    CHECK(!a.compare_exchange_strong(expected, Float24(9.0f)));
+    CHECK(expected.toFloat() == 3.0f);
+    CHECK(a.load().toFloat() == 3.0f);
+    CHECK(a.compare_exchange_strong(expected, Float24(9.0f)));
+    CHECK(a.load().toFloat() == 9.0f);
+
+    a.store(Float24()); // +0，按位比较时与 -0 不等
+    expected = Float24(-0.0f);
+    CHECK(!a.compare_exchange_strong(expected, Float24(1.0f)));
+    CHECK(expected.toBits() == 0);
+}
+
+// 分段 drain 与 finish 拼接后解码还原原序列；解码器可接管临时的流
+static void testCodecRoundTrip()
+{
+    const Float24Residual residuals[] = {Float24Residual::Xor, Float24Residual::Delta};
+    for (Float24Residual residual : residuals)
+    {
+        Float24XorEncoder encoder(100, residual);
+        std::vector<Float24> input, output;
+        for (int i = 0; i < 10007; i++)
+        {
+            input.push_back(Float24(static_cast<float>(std::sin(i * 0.01) * 100.0)));
+            encoder.push(input.back());
+            if (i % 37 == 0)
+            {
+                Float24XorDecoder decoder(encoder.drain());
+                CHECK(decoder.size() % 100 == 0);
+                Float24 value;
+                while (decoder.next(value))
+                    output.push_back(value);
+            }
+        }
+        const Float24XorStream &rest = encoder.finish();
+        Float24XorDecoder decoder(rest);
+        std::vector<Float24> tail(decoder.size());
+        decoder.decodeAll(tail.data());
+        output.insert(output.end(), tail.begin(), tail.end());
+
+        CHECK(output.size() == input.size());
+        for (size_t i = 0; i < input.size() && i < output.size(); i++)
+            CHECK(output[i].toBits() == input[i].toBits());
+        if (!tail.empty())
+            CHECK(decoder.at(tail.size() - 1).toBits() == input.back().toBits());
+    }
+}
+
+// 各位宽写入再读出，误差不超过半个量化步长；被截断的文件返回已读到的帧
+static void testWavRoundTrip()
+{
+    const std::string path = "float24_test.wav";
+    const uint16_t bit_depths[] = {16, 24, 32};
+    const size_t frames = 10000;
+    std::vector<Float24> input(2 * frames), output(2 * frames);
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = Float24(static_cast<float>(std::sin(i * 0.001) * 0.9));
+
+    for (uint16_t bits : bit_depths)
+    {
+        {
+            Float24WavWriter writer(path, 2, 48000, bits);
+            writer.write(input.data(), frames / 2);
+            writer.write(input.data() + frames, frames - frames / 2);
+        }
+        Float24WavReader reader(path);
+        CHECK(reader.getChannels() == 2 && reader.getSampleRate() == 48000 && reader.getBitsPerSample() == bits);
+        CHECK(reader.getFrames() == frames);
+        size_t done = 0, n;
+        while ((n = reader.read(output.data() + 2 * done, 777)) != 0)
+            done += n;
+        CHECK(done == frames);
+        float tolerance = bits == 16 ? 0.5f / 32768.0f : 1e-6f;
+        for (size_t i = 0; i < input.size(); i++)
+            CHECK(std::fabs(input[i].toFloat() - output[i].toFloat()) <= tolerance);
+
+        // 截断到 3000 帧加半帧
+        std::vector<char> bytes(44 + 3000 * 2 * (bits / 8) + 3);
+        {
+            std::ifstream in(path, std::ios::binary);
+            in.read(bytes.data(), bytes.size());
+        }
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), bytes.size());
+        }
+        Float24WavReader truncated(path);
+        done = 0;
+        while ((n = truncated.read(output.data() + 2 * done, 1000)) != 0)
+            done += n;
+        CHECK(done == 3000);
+    }
+    std::remove(path.c_str());
+}
+
+// PCM 输出：四舍五入远离零，超出位宽时饱和，NaN 输出 0；长度覆盖向量化的主循环与尾部
+static void testPcmRounding()
+{
+    const float values[] = {0.0f, -0.0f, 0.49f, 0.5f, -0.5f, 1.5f, -1.5f, 2.25f, -2.75f, 32766.5f, 32767.4f,
+                            -32767.5f, -32768.0f, 40000.0f, -40000.0f, 1e30f, -1e30f};
+    const int16_t expected16[] = {0, 0, 0, 1, -1, 2, -2, 2, -3, 32767, 32767, -32768, -32768, 32767, -32768, 32767, -32768};
+    const size_t count = sizeof(values) / sizeof(values[0]);
+    const size_t n = 8 * count + 3;
+    std::vector<Float24> in(n);
+    for (size_t i = 0; i < n; i++)
+        in[i] = i < 8 * count ? Float24(values[i % count]) : Float24::qNaN();
+    in[n - 2].setSign(true); // -NaN
+
+    std::vector<int16_t> pcm16(n);
+    std::vector<uint8_t> pcm24(3 * n);
+    std::vector<int32_t> int32(n);
+    const Float24Kernels &kernels = float24Kernels();
+    kernels.toPcm16(in.data(), pcm16.data(), n, 1.0f);
+    kernels.toPcm24(in.data(), pcm24.data(), n, 256.0f);
+    kernels.toInt32(in.data(), int32.data(), n, 65536.0f);
+    for (size_t i = 0; i < n; i++)
+    {
+        int32_t sample24 = static_cast<int32_t>(static_cast<uint32_t>(pcm24[3 * i]) << 8 | static_cast<uint32_t>(pcm24[3 * i + 1]) << 16 |
+                                                static_cast<uint32_t>(pcm24[3 * i + 2]) << 24) >>
+                           8;
+        if (i >= 8 * count)
+        {
+            CHECK(pcm16[i] == 0 && sample24 == 0 && int32[i] == 0);
+            continue;
+        }
+        float v = in[i].toFloat();
+        CHECK(pcm16[i] == expected16[i % count]);
+        double scaled24 = std::max(-8388608.0, std::min(8388607.0, static_cast<double>(v) * 256.0));
+        CHECK(sample24 == static_cast<int32_t>(scaled24 + (scaled24 < 0 ? -0.5 : 0.5)));
+        double scaled32 = std::max(-2147483648.0, std::min(2147483520.0, static_cast<double>(v) * 65536.0));
+        CHECK(int32[i] == static_cast<int32_t>(scaled32 + (scaled32 < 0 ? -0.5 : 0.5)));
+    }
+}
+
+// 按不均匀的段长（跨块边界）把 in 送入 process
+template <typename Process>
+static void feedUneven(size_t n, Process process)
+{
+    const size_t splits[] = {1, 1500, 7, 1023};
+    for (size_t done = 0, i = 0; done < n; i++)
+    {
+        size_t m = std::min(splits[i % 4], n - done);
+        process(done, m);
+        done += m;
+    }
+}
+
+static std::vector<Float24> filterInput(size_t n)
+{
+    Float24Rng rng(31);
+    std::vector<Float24> x(n);
+    for (size_t i = 0; i < n; i++)
+        x[i] = Float24(static_cast<float>(rng.next() % 20001) / 10000.0f - 1.0f);
+    return x;
+}
+
+// 直接卷积，在 f32 中按与内核相同的顺序（最早的采样在前）求和：y[j] = Σ h[k] x[j * factor - k]
+static float directFir(const std::vector<float> &h, const std::vector<Float24> &x, size_t index)
+{
+    float sum = 0.0f;
+    for (size_t k = h.size(); k-- > 0;)
+        sum += h[k] * (index >= k ? x[index - k].toFloat() : 0.0f);
+    return sum;
+}
+
+// FIR 与抽取器（含大于 block_size 的抽取因子）与直接卷积逐位一致
+static void testFirDecimator()
+{
+    const std::vector<float> h = {0.125f, -0.3f, 0.7f, 0.25f, -0.0625f, 0.01f, 0.5f};
+    const size_t n = 10000;
+    std::vector<Float24> x = filterInput(n), y(n);
+
+    Float24Fir fir(h);
+    feedUneven(n, [&](size_t done, size_t m)
+               { fir.process(x.data() + done, y.data() + done, m); });
+    for (size_t j = 0; j < n; j++)
+        CHECK(y[j].toBits() == Float24::truncate(directFir(h, x, j)).toBits());
+
+    const size_t factors[] = {1, 3, 1024, 1500};
+    for (size_t factor : factors)
+    {
+        Float24Decimator decimator(h, factor);
+        std::vector<Float24> out(n / factor + 1);
+        size_t produced = 0;
+        feedUneven(n, [&](size_t done, size_t m)
+                   { produced += decimator.process(x.data() + done, out.data() + produced, m); });
+        CHECK(produced == (n - 1) / factor + 1);
+        for (size_t j = 0; j < produced; j++)
+            CHECK(out[j].toBits() == Float24::truncate(directFir(h, x, j * factor)).toBits());
+    }
+}
+
+// 插值器与补零后的直接卷积逐位一致，求和顺序同多相子滤波器（含补齐的零系数）
+static void testInterpolator()
+{
+    const std::vector<float> h = {0.125f, -0.3f, 0.7f, 0.25f, -0.0625f, 0.01f, 0.5f};
+    const size_t n = 5000, factor = 3, length = (h.size() + factor - 1) / factor;
+    std::vector<Float24> x = filterInput(n), y(n * factor);
+    Float24Interpolator interpolator(h, factor);
+    feedUneven(n, [&](size_t done, size_t m)
+               { interpolator.process(x.data() + done, y.data() + done * factor, m); });
+    for (size_t j = 0; j < n; j++)
+        for (size_t p = 0; p < factor; p++)
+        {
+            float sum = 0.0f;
+            for (size_t k = length; k-- > 0;)
+            {
+                float coefficient = p + k * factor < h.size() ? h[p + k * factor] : 0.0f;
+                sum += coefficient * (j >= k ? x[j - k].toFloat() : 0.0f);
+            }
+            CHECK(y[j * factor + p].toBits() == Float24::truncate(sum).toBits());
+        }
+}
+
+// 级联双二阶节与逐采样的转置直接 II 型递推逐位一致
+static void testBiquadCascade()
+{
+    const std::vector<Float24BiquadCoefficients> sections = {
+        {0.2929, 0.5858, 0.2929, 0.0, 0.1716},
+        {0.9, -1.7, 0.85, -1.6, 0.81},
+    };
+    const size_t n = 10000;
+    std::vector<Float24> x = filterInput(n), y(n);
+    Float24BiquadCascade cascade(sections);
+    feedUneven(n, [&](size_t done, size_t m)
+               { cascade.process(x.data() + done, y.data() + done, m); });
+
+    std::vector<double> state(2 * sections.size(), 0.0);
+    for (size_t i = 0; i < n; i++)
+    {
+        double v = x[i].toFloat();
+        for (size_t s = 0; s < sections.size(); s++)
+        {
+            const Float24BiquadCoefficients &c = sections[s];
+            double out = c.b0 * v + state[2 * s];
+            state[2 * s] = c.b1 * v - c.a1 * out + state[2 * s + 1];
+            state[2 * s + 1] = c.b2 * v - c.a2 * out;
+            v = out;
+        }
+        CHECK(y[i].toBits() == Float24::truncate(static_cast<float>(v)).toBits());
+    }
+}
+
+// 正变换与 f64 直接 DFT 一致，逆变换还原输入；分离布局与批量变换与交错布局逐位一致
+static void testFft()
+{
+    const double pi = std::acos(-1.0);
+    const size_t sizes[] = {1, 2, 8, 32};
+    Float24Rng rng(32);
+    for (size_t n : sizes)
+    {
+        Float24Fft fft(n);
+        std::vector<Complex24> x(n);
+        for (size_t j = 0; j < n; j++)
+            x[j] = Complex24(std::complex<float>(static_cast<float>(rng.next() % 2001) / 1000.0f - 1.0f,
+                                                 static_cast<float>(rng.next() % 2001) / 1000.0f - 1.0f));
+
+        std::vector<Complex24> y = x;
+        fft.forward(y.data());
+        // 每级蝶形舍入一次，误差随 n 增长；|x[j]| <= sqrt(2)，ulp(1) = 2^-16
+        double tolerance = 1e-5 * n;
+        for (size_t k = 0; k < n; k++)
+        {
+            std::complex<double> expected = 0.0;
+            for (size_t j = 0; j < n; j++)
+                expected += std::complex<double>(x[j].re.toFloat(), x[j].im.toFloat()) * std::polar(1.0, -2.0 * pi * j * k / n);
+            CHECK(std::abs(std::complex<double>(y[k].re.toFloat(), y[k].im.toFloat()) - expected) <= tolerance);
+        }
+
+        std::vector<Float24> re(n), im(n);
+        for (size_t j = 0; j < n; j++)
+        {
+            re[j] = x[j].re;
+            im[j] = x[j].im;
+        }
+        fft.forward(Complex24Split{re.data(), im.data()});
+        for (size_t k = 0; k < n; k++)
+            CHECK(re[k].toBits() == y[k].re.toBits() && im[k].toBits() == y[k].im.toBits());
+
+        std::vector<Complex24> batch;
+        for (int copy = 0; copy < 3; copy++)
+            batch.insert(batch.end(), x.begin(), x.end());
+        fft.forwardBatch(batch.data(), 3, 2);
+        for (size_t i = 0; i < batch.size(); i++)
+            CHECK(batch[i].re.toBits() == y[i % n].re.toBits() && batch[i].im.toBits() == y[i % n].im.toBits());
+
+        fft.inverse(y.data());
+        fft.inverse(Complex24Split{re.data(), im.data()});
+        fft.inverseBatch(batch.data(), 3, 2);
+        for (size_t j = 0; j < n; j++)
+        {
+            CHECK(std::abs(y[j].toComplex() - x[j].toComplex()) <= 5e-5f);
+            CHECK(re[j].toBits() == y[j].re.toBits() && im[j].toBits() == y[j].im.toBits());
+        }
+        for (size_t i = 0; i < batch.size(); i++)
+            CHECK(batch[i].re.toBits() == y[i % n].re.toBits() && batch[i].im.toBits() == y[i % n].im.toBits());
+    }
+}
+
+// 分位数与排序结果一致；NaN（两种符号）单独计数；rank(-0) 计入 +0
+static void testHistogramQuantiles()
+{
+    Float24Rng rng(33);
+    std::vector<Float24> values;
+    for (int i = 0; i < 100000; i++)
+    { // Box-Muller
+        double u1 = (rng.next() + 1.0) / 4294967296.0, u2 = rng.next() / 4294967296.0;
+        values.push_back(Float24(static_cast<float>(std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::acos(-1.0) * u2))));
+    }
+    values.push_back(Float24());
+    values.push_back(Float24(-0.0f));
+    values.push_back(Float24());
+
+    Float24Histogram histogram;
+    histogram.add(values.data(), values.size());
+    Float24 nan = Float24::qNaN(), negative_nan = Float24::qNaN();
+    negative_nan.setSign(true);
+    const Float24 nans[] = {nan, negative_nan, Float24::fromBits(0x7F0001), Float24::fromBits(0xFF0001)};
+    for (Float24 value : nans)
+        for (int i = 0; i < 5; i++)
+            histogram.add(value);
+
+    CHECK(histogram.count() == values.size());
+    CHECK(histogram.nanCount() == 20);
+    CHECK(histogram.count(Float24(-0.0f)) == 1 && histogram.count(Float24()) == 2);
+
+    std::vector<float> sorted;
+    for (Float24 value : values)
+        sorted.push_back(value.toFloat());
+    std::sort(sorted.begin(), sorted.end());
+    const double qs[] = {0.0, 1e-5, 0.001, 0.25, 0.5, 0.9, 0.999, 1.0};
+    for (double q : qs)
+    {
+        size_t r = static_cast<size_t>(std::ceil(q * sorted.size()));
+        r = r < 1 ? 1 : r;
+        CHECK(histogram.quantile(q).toFloat() == sorted[r - 1]);
+    }
+
+    uint64_t non_positive = std::upper_bound(sorted.begin(), sorted.end(), 0.0f) - sorted.begin();
+    CHECK(histogram.rank(Float24(-0.0f)) == non_positive);
+    CHECK(histogram.rank(Float24()) == non_positive);
+    CHECK(histogram.rank(Float24(-1.0f)) == static_cast<uint64_t>(std::upper_bound(sorted.begin(), sorted.end(), -1.0f) - sorted.begin()));
+}
+
+// addParallel（多于 2^24 个元素，4 线程）与逐个 add 的计数完全一致
+static void testHistogramParallel()
+{
+    Float24Rng rng(34);
+    std::vector<Float24> values((size_t(1) << 24) + 12345);
+    for (Float24 &value : values)
+        value = Float24::fromBits(rng.next() & 0xFFFFFF);
+    Float24Histogram serial, parallel;
+    serial.add(values.data(), values.size());
+    parallel.addParallel(values.data(), values.size(), 4);
+    CHECK(parallel.count() == serial.count() && parallel.nanCount() == serial.nanCount());
+    uint64_t mismatches = 0;
+    for (uint32_t key = 0; key < Float24Histogram::key_count; key++)
+        mismatches += parallel.count(Float24::fromOrderKey(key)) != serial.count(Float24::fromOrderKey(key));
+    CHECK(mismatches == 0);
+    CHECK(parallel.median().toBits() == serial.median().toBits());
+}
+
+// 融合表达式与逐个运算在 f32 中计算的结果一致，长度不符时抛出异常
+static void testArrayExpressions()
+{
+    const size_t n = 1000;
+    Float24Array a(n), b(n), c(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = Float24(static_cast<float>(i) * 0.37f - 100.0f);
+        b[i] = Float24(1.0f / static_cast<float>(i + 1));
+        c[i] = Float24(static_cast<float>(i % 7));
+    }
+    Float24Array out = a * b + 2.0f * c - Float24(1.5f);
+    CHECK(out.size() == n);
+    for (size_t i = 0; i < n; i++)
+    {
+        float expected = a[i].toFloat() * b[i].toFloat() + 2.0f * c[i].toFloat() - 1.5f;
+        CHECK(out[i].toBits() == Float24::truncate(expected).toBits());
+    }
+
+    Float24Array empty, short_array(3);
+    bool thrown = false;
+    try
+    {
+        Float24Array bad = empty + a;
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    thrown = false;
+    try
+    {
+        out = short_array * a;
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+// 与标量的复合赋值等价于 a = a op s
+static void testArrayCompoundScalar()
+{
+    const size_t n = 100;
+    Float24Array a(n);
+    for (size_t i = 0; i < n; i++)
+        a[i] = Float24(static_cast<float>(i) * 0.37f - 10.0f);
+    Float24Array b = a;
+    b += 1.25f;
+    b *= Float24(3.0f);
+    b -= Float24(0.5f);
+    b /= 7.0f;
+    for (size_t i = 0; i < n; i++)
+    {
+        float expected = Float24::truncate(a[i].toFloat() + 1.25f).toFloat();
+        expected = Float24::truncate(expected * 3.0f).toFloat();
+        expected = Float24::truncate(expected - 0.5f).toFloat();
+        expected = Float24::truncate(expected / 7.0f).toFloat();
+        CHECK(b[i].toBits() == Float24::truncate(expected).toBits());
+    }
+}
+
+// 可复现的伪随机位模式，偏向非规格化数、特殊值与阶码边界
+static uint32_t randomBits(Float24Rng &rng)
+{
+    static const uint32_t specials[] = {0x000000, 0x800000, 0x7F0000, 0xFF0000, 0x7F8000,
+                                        0x3F0000, 0x3FFFFF, 0x000001, 0x010000, 0x7EFFFF};
+    uint32_t r = rng.next();
+    uint32_t sign = r & 0x800000;
+    switch (r & 7)
+    {
+    case 0: // 非规格化数
+        return sign | (rng.next() & 0xFFFF);
+    case 1: // 结果接近下溢
+        return sign | (25 + rng.next() % 12) << 16 | (rng.next() & 0xFFFF);
+    case 2: // 结果接近上溢
+        return sign | (90 + rng.next() % 37) << 16 | (rng.next() & 0xFFFF);
+    case 3:
+        return specials[rng.next() % (sizeof(specials) / sizeof(specials[0]))];
+    default:
+        return rng.next() & 0xFFFFFF;
+    }
+}
+
+// 软浮点与经 f32 计算后截断的结果逐位一致（NaN 只比较是否为 NaN）
+static void testSoftMatchesFloat()
+{
+    Float24Rng rng(36);
+    long mismatches = 0;
+    for (int i = 0; i < 2000000; i++)
+    {
+        uint32_t a = randomBits(rng), b = randomBits(rng);
+        float fa = float24BitsToFloat(a), fb = float24BitsToFloat(b);
+        const uint32_t expected[] = {float24BitsFromFloat(fa + fb), float24BitsFromFloat(fa - fb),
+                                     float24BitsFromFloat(fa * fb), float24BitsFromFloat(fa / fb)};
+        const uint32_t actual[] = {float24SoftAdd(a, b), float24SoftSub(a, b), float24SoftMul(a, b), float24SoftDiv(a, b)};
+        for (int k = 0; k < 4; k++)
+        {
+            bool nan = float24SoftIsNaN(expected[k]);
+            if (nan != float24SoftIsNaN(actual[k]) || (!nan && expected[k] != actual[k]))
+                mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// 标量运算符与批量内核逐位一致
+static void testOperatorsMatchBatch()
+{
+    Float24Rng rng(7);
+    const size_t n = 4096;
+    std::vector<Float24> a(n), b(n), sum(n), product(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = Float24::fromBits(randomBits(rng));
+        b[i] = Float24::fromBits(randomBits(rng));
+    }
+    float24Add(a.data(), b.data(), sum.data(), n);
+    float24Mul(a.data(), b.data(), product.data(), n);
+    for (size_t i = 0; i < n; i++)
+    {
+        Float24 s = a[i] + b[i], p = a[i] * b[i];
+        CHECK(s.isNaN() ? sum[i].isNaN() : s.toBits() == sum[i].toBits());
+        CHECK(p.isNaN() ? product[i].isNaN() : p.toBits() == product[i].toBits());
+    }
+}
+
+int main()
+{
+    std::cout << "backend: " << float24BackendName() << ", isa: " << float24IsaName(float24Kernels().isa) << std::endl;
+    testStochasticUnbiased();
+    testStochasticBatchSplit();
+    testStochasticSpecials();
+    testAtomicFetchAdd();
+    testAtomicMinMaxCas();
+    testCodecRoundTrip();
+    testWavRoundTrip();
+    testPcmRounding();
+    testFirDecimator();
+    testInterpolator();
+    testBiquadCascade();
+    testFft();
+    testHistogramQuantiles();
+    testHistogramParallel();
+    testArrayExpressions();
+    testArrayCompoundScalar();
+    testSoftMatchesFloat();
+    testOperatorsMatchBatch();
+    if (failures)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "all tests passed" << std::endl;
+    return 0;
+}